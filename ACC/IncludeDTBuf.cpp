@@ -19,10 +19,327 @@
 #include "CPP/IStream.hpp"
 #include "CPP/Macro.hpp"
 
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
 #include "Core/Path.hpp"
+#include "Core/SHA256.hpp"
+#include "Core/StringBuf.hpp"
+
+#include "Option/CStr.hpp"
 
 #include "SR/Statement.hpp"
 
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // --import-cache
+   //
+   static Option::CStr ImportCacheDir
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("import-cache")
+         .setGroup("preprocessor")
+         .setDescS("Sets a directory for cached #import token files.")
+         .setDescL("Sets a directory for cached #import token files. When "
+            "set, the lexed tokens of each imported library are written to "
+            "a file named by the SHA-256 digest of its contents, and later "
+            "imports of identical contents map that file instead of lexing "
+            "the library again.")
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // ImportToks
+   //
+   class ImportToks
+   {
+   public:
+      Core::String             file;
+      std::size_t              size;
+      std::vector<Core::Token> toks;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::ACC
+{
+   static char const ImportCacheMagic[8] = {'G','D','C','C','A','T','K','2'};
+
+   // Lexed imports, by content digest.
+   static std::unordered_map<std::string, ImportToks> ImportCache;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // GetImportCachePath
+   //
+   static std::string GetImportCachePath(std::string const &digest)
+   {
+      std::string path{ImportCacheDir.data(), ImportCacheDir.size()};
+      std::string name = digest + ".acstok";
+
+      Core::PathAppend(path, {name.data(), name.size()});
+      return path;
+   }
+
+   //
+   // GetU32
+   //
+   static bool GetU32(char const *&itr, char const *end, std::uint_fast32_t &out)
+   {
+      if(end - itr < 4)
+         return false;
+
+      out = 0;
+      for(int i = 0; i != 4; ++i)
+         out |= static_cast<std::uint_fast32_t>(static_cast<unsigned char>(*itr++)) << (i * 8);
+
+      return true;
+   }
+
+   //
+   // PutU32
+   //
+   static void PutU32(std::string &out, std::uint_fast32_t in)
+   {
+      for(int i = 0; i != 4; ++i)
+         out += static_cast<char>((in >> (i * 8)) & 0xFF);
+   }
+
+   //
+   // LoadImportCache
+   //
+   // Reads the tokens of an import from its cache file, if the file exists
+   // and was made from the same contents by the same build.
+   //
+   static bool LoadImportCache(Core::FileBlock const &src,
+      std::string const &digest, ImportToks &out)
+   {
+      std::unique_ptr<Core::FileBlock> buf;
+
+      try
+      {
+         buf = Core::FileOpenBlock(GetImportCachePath(digest).data());
+      }
+      catch(Core::Exception const &)
+      {
+         return false;
+      }
+
+      char const *itr = buf->begin(), *end = buf->end();
+
+      if(end - itr < 8 || !std::equal(itr, itr + 8, ImportCacheMagic))
+         return false;
+      itr += 8;
+
+      // Header: source size and digest, and the build's digest.
+      auto const &build = Core::GetOptionBuild();
+
+      std::uint_fast32_t size;
+      if(!GetU32(itr, end, size) || size != src.size())
+         return false;
+
+      if(static_cast<std::size_t>(end - itr) < digest.size() + build.size() ||
+         digest.compare(0, digest.size(), itr, digest.size()) ||
+         build.compare(0, build.size(), itr + digest.size(), build.size()))
+         return false;
+      itr += digest.size() + build.size();
+
+      // String table.
+      std::uint_fast32_t strC;
+      if(!GetU32(itr, end, strC))
+         return false;
+
+      std::vector<Core::String> strs;
+      strs.reserve(strC);
+      for(std::uint_fast32_t len; strC--;)
+      {
+         if(!GetU32(itr, end, len))
+            return false;
+
+         // Null strings are marked by an all-ones length.
+         if(len == 0xFFFFFFFF)
+         {
+            strs.emplace_back(nullptr);
+            continue;
+         }
+
+         if(static_cast<std::size_t>(end - itr) < len)
+            return false;
+
+         strs.emplace_back(itr, len);
+         itr += len;
+      }
+
+      // Tokens.
+      std::uint_fast32_t tokC;
+      if(!GetU32(itr, end, tokC))
+         return false;
+
+      out.toks.clear();
+      out.toks.reserve(tokC);
+      for(std::uint_fast32_t tok, str, line, col; tokC--;)
+      {
+         if(!GetU32(itr, end, tok) || !GetU32(itr, end, str) ||
+            !GetU32(itr, end, line) || !GetU32(itr, end, col) || str >= strs.size())
+            return false;
+
+         out.toks.emplace_back(Core::Origin{out.file, line, col}, strs[str],
+            static_cast<Core::TokenType>(tok));
+      }
+
+      return true;
+   }
+
+   //
+   // SaveImportCache
+   //
+   // Writes the tokens of an import to its cache file. Failure to write is
+   // not an error, as the cache only saves work.
+   //
+   static void SaveImportCache(Core::FileBlock const &src,
+      std::string const &digest, ImportToks const &in)
+   {
+      std::string out{ImportCacheMagic, sizeof(ImportCacheMagic)};
+
+      PutU32(out, src.size());
+      out += digest;
+      out += Core::GetOptionBuild();
+
+      // String table.
+      std::unordered_map<Core::String, std::uint_fast32_t> strIdx;
+      std::vector<Core::String>                            strs;
+
+      for(auto const &tok : in.toks)
+      {
+         if(strIdx.emplace(tok.str, strs.size()).second)
+            strs.push_back(tok.str);
+      }
+
+      PutU32(out, strs.size());
+      for(auto const &str : strs)
+      {
+         if(!str)
+         {
+            PutU32(out, 0xFFFFFFFF);
+            continue;
+         }
+
+         PutU32(out, str.size());
+         out.append(str.data(), str.size());
+      }
+
+      // Tokens.
+      PutU32(out, in.toks.size());
+      for(auto const &tok : in.toks)
+      {
+         PutU32(out, tok.tok);
+         PutU32(out, strIdx[tok.str]);
+         PutU32(out, tok.pos.line);
+         PutU32(out, tok.pos.col);
+      }
+
+      // Write to a unique temporary, then rename into place, so that other
+      // builds sharing the directory only ever see complete files.
+      auto path = GetImportCachePath(digest);
+      auto tmp  = path + '.' + std::to_string(std::random_device{}()) + ".tmp";
+
+      {
+         std::filebuf fbuf;
+         if(!fbuf.open(tmp.data(), std::ios_base::out | std::ios_base::binary))
+            return;
+
+         if(fbuf.sputn(out.data(), out.size()) !=
+            static_cast<std::streamsize>(out.size()) || !fbuf.close())
+         {
+            std::remove(tmp.data());
+            return;
+         }
+      }
+
+      if(std::rename(tmp.data(), path.data()))
+         std::remove(tmp.data());
+   }
+
+   //
+   // GetImportToks
+   //
+   // Returns the lexed tokens of an import. Identical contents are only lexed
+   // once per process and, with --import-cache, once across processes.
+   //
+   static ImportToks const &GetImportToks(Core::String name)
+   {
+      auto src    = Core::FileOpenBlock(name.data());
+      auto digest = Core::GetSHA256Hex(src->data(), src->size());
+
+      auto itr = ImportCache.find(digest);
+      if(itr != ImportCache.end() && itr->second.size == src->size())
+      {
+         // Token origins name the file as first imported.
+         if(itr->second.file != name)
+         {
+            itr->second.file = name;
+            for(auto &tok : itr->second.toks)
+               tok.pos.file = name;
+         }
+
+         return itr->second;
+      }
+
+      auto &toks = ImportCache[digest];
+      toks.file = name;
+      toks.size = src->size();
+
+      // Without the build's digest, files from other builds cannot be told
+      // apart.
+      bool useDir = ImportCacheDir.data() && !Core::GetOptionBuild().empty();
+
+      if(useDir && LoadImportCache(*src, digest, toks))
+         return toks;
+
+      Core::StringBuf sbuf{src->data(), src->size()};
+      CPP::IStream    istr{sbuf, name};
+      TSource         tsrc{istr, istr.getOriginSource()};
+
+      toks.toks.clear();
+      for(Core::Token tok; (tok = tsrc.getToken()).tok != Core::TOK_EOF;)
+         toks.toks.push_back(tok);
+
+      if(useDir)
+         SaveImportCache(*src, digest, toks);
+
+      return toks;
+   }
+}
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -105,12 +422,15 @@ namespace GDCC::ACC
    //
    // ImportDTBuf::doInc
    //
-   void ImportDTBuf::doInc(Core::String name,
-      std::unique_ptr<std::streambuf> &&newBuf)
+   // Imported libraries are read from an already lexed token array, since
+   // the same library is commonly imported by every translation unit.
+   //
+   void ImportDTBuf::doInc(Core::String name, std::unique_ptr<std::streambuf> &&)
    {
-      CPP::IStream istr{*newBuf, name};
-      TSource      tsrc{istr, istr.getOriginSource()};
-      ImportStream tstr{tsrc, macros, pragd, pragp};
+      auto const &toks = GetImportToks(name);
+
+      Core::ArrayTSource asrc{toks.toks.data(), toks.toks.size()};
+      ImportStream       tstr{asrc, macros, pragd, pragp};
       Parser       ctx {tstr, fact, pragd, prog, true};
 
       pragd.push();
@@ -24,6 +24,7 @@
 
 #include "Core/File.hpp"
 #include "Core/Path.hpp"
+#include "Core/Stats.hpp"
 #include "Core/StringBuf.hpp"
 
 #include "IR/Program.hpp"
@@ -59,8 +60,12 @@ namespace GDCC::ACC
       Parser           ctx  {tstr, fact, pragd, prog};
 
       // Read declarations.
-      while(ctx.in.peek().tok != Core::TOK_EOF)
-         ctx.getDecl(scope);
+      {
+         Core::StatPhase phase{"parse"};
+
+         while(ctx.in.peek().tok != Core::TOK_EOF)
+            ctx.getDecl(scope);
+      }
 
       // Add ACS libraries.
       for(auto const &lib : pragd.stateLibrary)
@@ -69,6 +74,7 @@ namespace GDCC::ACC
       scope.allocAuto();
 
       // Generate IR data.
+      Core::StatPhase phase{"genIR"};
       scope.genIR(prog);
    }
 }
@@ -12,28 +12,11 @@
 
 #include "ACC/TSource.hpp"
 
+#include "Core/CharClass.hpp"
 #include "Core/Exception.hpp"
 #include "Core/Parse.hpp"
 #include "Core/Token.hpp"
 
-#include <cctype>
-
-
-//----------------------------------------------------------------------------|
-// Static Functions                                                           |
-//
-
-namespace GDCC::ACC
-{
-   //
-   // IsIdentiChar
-   //
-   static bool IsIdentiChar(int c)
-   {
-      return std::isalnum(c) || c == '_' || c > 0x80;
-   }
-}
-
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -98,7 +81,7 @@ namespace GDCC::ACC
 
       case '.':
          // Is this actually a number?
-         if(std::isdigit(in.peek())) break;
+         if(Core::IsCharDigit(in.peek())) break;
 
          c = in.get();
          if(c == '.') {c = in.get();
@@ -158,13 +141,10 @@ namespace GDCC::ACC
       }
 
       // Whitespace token.
-      if(std::isspace(c))
+      if(Core::IsCharSpace(c))
       {
-         std::string str;
-
-         do str += static_cast<char>(c);
-         while((c = in.get()) != EOF && (std::isspace(c) && c != '\n'));
-         if(c != EOF) in.unget();
+         std::string str{static_cast<char>(c)};
+         Core::ReadCharClass(in, str, Core::CharSpaceH);
 
          tok.str = {str.data(), str.size()};
          tok.tok = Core::TOK_WSpace;
@@ -192,7 +172,7 @@ namespace GDCC::ACC
       }
 
       // Number token.
-      if(std::isdigit(c) || c == '.')
+      if(Core::IsCharDigit(c) || c == '.')
       {
          in.putback(c);
 
@@ -204,13 +184,10 @@ namespace GDCC::ACC
       }
 
       // Identifier token.
-      if(IsIdentiChar(c))
+      if(Core::IsCharIdenti(c))
       {
-         std::string str;
-
-         do str += static_cast<char>(std::tolower(c));
-         while((c = in.get()) != EOF && IsIdentiChar(c));
-         if(c != EOF) in.unget();
+         std::string str{static_cast<char>(Core::ToCharLower(c))};
+         Core::ReadCharClassLower(in, str, Core::CharIdenti);
 
          tok.str = {str.data(), str.size()};
          tok.tok = Core::TOK_Identi;
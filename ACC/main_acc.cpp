@@ -12,6 +12,7 @@
 
 #include "ACC/Parse.hpp"
 
+#include "CPP/Depend.hpp"
 #include "CPP/IncludeDTBuf.hpp"
 
 #include "Core/File.hpp"
@@ -19,6 +20,7 @@
 
 #include "IR/Program.hpp"
 
+#include "LD/Cache.hpp"
 #include "LD/Linker.hpp"
 
 #include "Target/Info.hpp"
@@ -55,13 +57,22 @@ static void MakeACS()
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      GDCC::ACC::ParseFile(arg, prog);
+   {
+      GDCC::LD::CacheParse(arg, prog, GDCC::ACC::ParseFile);
+      GDCC::CPP::DependAdd(arg);
+   }
 
    for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
-      GDCC::ACC::ParseFile(arg, prog);
+   {
+      GDCC::LD::CacheParse(arg, prog, GDCC::ACC::ParseFile);
+      GDCC::CPP::DependAdd(arg);
+   }
 
-   // Write output.
-   GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
+   // Write output. ACS sources are parsed in full even for -M, since
+   // #import needs the library's declarations.
+   if(!GDCC::CPP::IsDependOnly())
+      GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
+   GDCC::CPP::DependPut(GDCC::Core::GetOptionOutput());
 }
 
 //
@@ -85,7 +96,7 @@ static void MakeACSAlt()
    }
 
    // Process input.
-   GDCC::ACC::ParseFile(file.data(), prog);
+   GDCC::LD::CacheParse(file.data(), prog, GDCC::ACC::ParseFile);
 
    // Replace extension with .o for output.
    file.resize(dot + 2);
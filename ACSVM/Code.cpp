@@ -0,0 +1,175 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS instruction codes.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACSVM/Code.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // CodeName
+   //
+   class CodeName
+   {
+   public:
+      Word        code;
+      char const *name;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::ACSVM
+{
+   // Sorted by code.
+   static CodeName const CodeNames[] =
+   {
+      {  0, "Nop"},
+      {  1, "Rscr"},
+      {  3, "Push_Lit"},
+      {  4, "Cspe_1"},
+      {  5, "Cspe_2"},
+      {  6, "Cspe_3"},
+      {  7, "Cspe_4"},
+      {  8, "Cspe_5"},
+      {  9, "Cspe_1L"},
+      { 10, "Cspe_2L"},
+      { 11, "Cspe_3L"},
+      { 12, "Cspe_4L"},
+      { 13, "Cspe_5L"},
+      { 14, "AddU"},
+      { 15, "SubU"},
+      { 16, "MulU"},
+      { 17, "DivI"},
+      { 18, "ModI"},
+      { 19, "CmpU_EQ"},
+      { 20, "CmpU_NE"},
+      { 21, "CmpI_LT"},
+      { 22, "CmpI_GT"},
+      { 23, "CmpI_LE"},
+      { 24, "CmpI_GE"},
+      { 25, "Drop_LocReg"},
+      { 26, "Drop_ModReg"},
+      { 27, "Drop_HubReg"},
+      { 28, "Push_LocReg"},
+      { 29, "Push_ModReg"},
+      { 30, "Push_HubReg"},
+      { 31, "AddU_LocReg"},
+      { 32, "AddU_ModReg"},
+      { 33, "AddU_HubReg"},
+      { 34, "SubU_LocReg"},
+      { 35, "SubU_ModReg"},
+      { 36, "SubU_HubReg"},
+      { 46, "IncU_LocReg"},
+      { 47, "IncU_ModReg"},
+      { 48, "IncU_HubReg"},
+      { 49, "DecU_LocReg"},
+      { 50, "DecU_ModReg"},
+      { 51, "DecU_HubReg"},
+      { 52, "Jump_Lit"},
+      { 53, "Jcnd_Tru"},
+      { 54, "Drop_Nul"},
+      { 55, "Delay"},
+      { 56, "Wait_Lit"},
+      { 70, "LAnd"},
+      { 71, "LOrI"},
+      { 72, "BAnd"},
+      { 73, "BOrI"},
+      { 74, "BOrX"},
+      { 75, "LNot"},
+      { 76, "ShLU"},
+      { 77, "ShRI"},
+      { 78, "NegI"},
+      { 79, "Jcnd_Nil"},
+      { 84, "Jcnd_Lit"},
+      { 85, "BeginPrint"},
+      { 86, "EndPrint"},
+      { 87, "PrintString"},
+      { 88, "PrintNumber"},
+      { 89, "PrintChar"},
+      { 93, "Timer"},
+      {101, "EndPrintBold"},
+      {136, "MulX"},
+      {137, "DivX"},
+      {157, "PrintFixed"},
+      {181, "Drop_GblReg"},
+      {182, "Push_GblReg"},
+      {183, "AddU_GblReg"},
+      {184, "SubU_GblReg"},
+      {188, "IncU_GblReg"},
+      {189, "DecU_GblReg"},
+      {203, "Call_Lit"},
+      {204, "Call_Nul"},
+      {205, "Retn_Nul"},
+      {206, "Retn_Stk"},
+      {207, "Push_ModArr"},
+      {208, "Drop_ModArr"},
+      {216, "Copy"},
+      {217, "Swap"},
+      {225, "Pstr_Stk"},
+      {226, "Push_HubArr"},
+      {227, "Drop_HubArr"},
+      {235, "Push_GblArr"},
+      {236, "Drop_GblArr"},
+      {253, "StrLen"},
+      {256, "Jcnd_Tab"},
+      {257, "Drop_ScrRet"},
+      {263, "Cspe_5R1"},
+      {270, "EndLog"},
+      {275, "PrintGlobalCharArray"},
+      {330, "BNot"},
+      {350, "PrintHex"},
+      {351, "Cnat"},
+      {352, "EndStrParam"},
+      {355, "PrintGlobalCharRange"},
+      {359, "Pfun_Lit"},
+      {360, "Call_Stk"},
+      {363, "Jdyn"},
+      {364, "Drop_LocArr"},
+      {365, "Push_LocArr"},
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // GetCodeName
+   //
+   char const *GetCodeName(Word code)
+   {
+      auto itr = std::lower_bound(std::begin(CodeNames), std::end(CodeNames), code,
+         [](CodeName const &l, Word r) {return l.code < r;});
+
+      if(itr == std::end(CodeNames) || itr->code != code)
+         return nullptr;
+
+      return itr->name;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS instruction codes.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACSVM__Code_H__
+#define GDCC__ACSVM__Code_H__
+
+#include "../ACSVM/Types.hpp"
+
+#include "../BC/ZDACS/Code.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   using BC::ZDACS::Code;
+
+   //
+   // CodeExt
+   //
+   // Engine instructions the libraries use through AsmFunc, which the code
+   // generator does not emit itself.
+   //
+   namespace CodeExt
+   {
+      constexpr Word Delay                =  55;
+      constexpr Word BeginPrint           =  85;
+      constexpr Word EndPrint             =  86;
+      constexpr Word PrintString          =  87;
+      constexpr Word PrintNumber          =  88;
+      constexpr Word PrintChar            =  89;
+      constexpr Word Timer                =  93;
+      constexpr Word EndPrintBold         = 101;
+      constexpr Word PrintFixed           = 157;
+      constexpr Word StrLen               = 253;
+      constexpr Word EndLog               = 270;
+      constexpr Word PrintGlobalCharArray = 275;
+      constexpr Word PrintHex             = 350;
+      constexpr Word EndStrParam          = 352;
+      constexpr Word PrintGlobalCharRange = 355;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Objects                                                             |
+//
+
+namespace GDCC::ACSVM
+{
+   // Codes at or above this are counted together.
+   constexpr Word CodeMax = 512;
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   // Returns the instruction's name, or null if it is not executed.
+   char const *GetCodeName(Word code);
+}
+
+#endif//GDCC__ACSVM__Code_H__
+
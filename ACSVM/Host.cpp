@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS engine interface.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACSVM/Host.hpp"
+
+#include "ACSVM/Module.hpp"
+#include "ACSVM/VM.hpp"
+
+#include <iostream>
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // Execute
+   //
+   // Starts a script, unless it is already running and always is not set.
+   // For a result, the script is run at once and its result returned.
+   //
+   static Word Execute(VM &vm, Module *mod, Script *scr, Word const *argv,
+      Word argc, bool always, bool result)
+   {
+      if(!scr)
+         return 0;
+
+      if(!always && !result && vm.findThread(scr))
+         return 0;
+
+      auto thread = vm.startScript(*mod, *scr, argv, argc);
+
+      if(result)
+      {
+         vm.exec(*thread);
+         return thread->result;
+      }
+
+      return 1;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // Host::callFunc
+   //
+   Word Host::callFunc(Thread &thread, Word func, Word const *argv, Word argc)
+   {
+      auto getArg = [&](Word i) -> Word {return i < argc ? argv[i] : 0;};
+
+      switch(func)
+      {
+      case 15: // GetChar
+         if(auto str = thread.vm.getString(getArg(0)))
+         {
+            if(getArg(1) < str->size())
+               return static_cast<unsigned char>((*str)[getArg(1)]);
+         }
+         return 0;
+
+      case 39: // ACS_NamedExecute
+      case 44: // ACS_NamedExecuteWithResult
+      case 45: // ACS_NamedExecuteAlways
+         if(auto str = thread.vm.getString(getArg(0)))
+         {
+            Module *mod;
+            auto    scr = thread.vm.findScript(*str, mod);
+
+            // NamedExecuteWithResult has no map argument.
+            if(func == 44)
+               return Execute(thread.vm, mod, scr, argv + 1, argc ? argc - 1 : 0, false, true);
+
+            return Execute(thread.vm, mod, scr, argv + 2, argc > 2 ? argc - 2 : 0,
+               func == 45, false);
+         }
+         return 0;
+
+      default:
+         return 0;
+      }
+   }
+
+   //
+   // Host::callSpec
+   //
+   Word Host::callSpec(Thread &thread, Word spec, Word const *argv, Word argc)
+   {
+      if(!argc)
+         return 0;
+
+      Module *mod;
+      auto    scr = thread.vm.findScript(static_cast<WordS>(argv[0]), mod);
+
+      switch(spec)
+      {
+      case 80: // ACS_Execute
+      case 226: // ACS_ExecuteAlways
+         return Execute(thread.vm, mod, scr, argv + 2, argc > 2 ? argc - 2 : 0,
+            spec == 226, false);
+
+      case 84: // ACS_ExecuteWithResult
+         return Execute(thread.vm, mod, scr, argv + 1, argc - 1, false, true);
+
+      default:
+         return 0;
+      }
+   }
+
+   //
+   // Host::print
+   //
+   void Host::print(Thread &, std::string const &msg)
+   {
+      std::cout << msg << '\n';
+   }
+
+   //
+   // Host::tagString
+   //
+   Word Host::tagString(Thread &thread, Word str)
+   {
+      return str | thread.module->id;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,54 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS engine interface.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACSVM__Host_H__
+#define GDCC__ACSVM__Host_H__
+
+#include "../ACSVM/Types.hpp"
+
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // Host
+   //
+   // Handles the instructions that call into the engine. The defaults run
+   // scripts for the script execution specials and functions, provide a few
+   // string functions, and print to stdout. Everything else returns 0.
+   //
+   class Host
+   {
+   public:
+      virtual ~Host() {}
+
+      // Calls a native function, for Cnat.
+      virtual Word callFunc(Thread &thread, Word func, Word const *argv, Word argc);
+
+      // Calls a line special, for Cspe. The result is only used by Cspe_5R1.
+      virtual Word callSpec(Thread &thread, Word spec, Word const *argv, Word argc);
+
+      // Receives a completed print.
+      virtual void print(Thread &thread, std::string const &msg);
+
+      // Converts a module's string index to a string value, for Pstr_Stk.
+      virtual Word tagString(Thread &thread, Word str);
+   };
+}
+
+#endif//GDCC__ACSVM__Host_H__
+
@@ -0,0 +1,641 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS module loading.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACSVM/Module.hpp"
+
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Path.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // Chunk
+   //
+   class Chunk
+   {
+   public:
+      char const *name;
+      char const *data;
+      std::size_t size;
+   };
+
+   //
+   // ChunkReader
+   //
+   // Reads from a chunk's data, with every read checked against its end.
+   //
+   class ChunkReader
+   {
+   public:
+      ChunkReader(Module const &mod_, Chunk const &chunk_) :
+         mod{mod_}, chunk{chunk_}, pos{0} {}
+
+      bool empty() const {return pos == chunk.size;}
+
+      std::uint_fast8_t getByte() {return static_cast<unsigned char>(*get(1));}
+
+      std::uint_fast16_t getHWord()
+      {
+         auto p = reinterpret_cast<unsigned char const *>(get(2));
+         return p[0] | p[1] << 8;
+      }
+
+      Word getWord()
+      {
+         auto p = reinterpret_cast<unsigned char const *>(get(4));
+         return p[0] | p[1] << 8 | p[2] << 16 | static_cast<Word>(p[3]) << 24;
+      }
+
+      std::string getString();
+      std::string getString(std::size_t offset, Word key, bool encrypted);
+
+      std::vector<std::string> getStrTab(bool junk);
+
+      char const *get(std::size_t len);
+
+      Module const &mod;
+      Chunk  const &chunk;
+      std::size_t   pos;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // ChunkError
+   //
+   [[noreturn]] static void ChunkError(Module const &mod, char const *name,
+      char const *msg)
+   {
+      Core::Error({}, mod.name, ": ", std::string{name, 4}, ": ", msg);
+   }
+
+   //
+   // GetChunks
+   //
+   static std::vector<Chunk> GetChunks(Module const &mod)
+   {
+      auto data = mod.data;
+      auto size = mod.size;
+
+      auto getWord = [&](std::size_t pos) -> Word
+      {
+         auto p = reinterpret_cast<unsigned char const *>(data + pos);
+         return p[0] | p[1] << 8 | p[2] << 16 | static_cast<Word>(p[3]) << 24;
+      };
+
+      if(size < 8)
+         Core::Error({}, mod.name, ": not an ACS module");
+
+      std::size_t beg, end;
+
+      if(!std::memcmp(data, "ACSE", 4))
+      {
+         beg = getWord(4);
+         end = size;
+      }
+      else if(!std::memcmp(data, "ACS\0", 4))
+      {
+         // The ACSE header is just before the ACS0 directory.
+         std::size_t dir = getWord(4);
+
+         if(dir < 16 || dir > size || std::memcmp(data + dir - 4, "ACSE", 4))
+            Core::Error({}, mod.name, ": ACS0 modules are not supported");
+
+         beg = getWord(dir - 8);
+         end = dir - 8;
+      }
+      else
+         Core::Error({}, mod.name, ": not an ACS module");
+
+      std::vector<Chunk> chunks;
+
+      while(beg < end)
+      {
+         if(end - beg < 8)
+            Core::Error({}, mod.name, ": truncated chunk header");
+
+         std::size_t len = getWord(beg + 4);
+
+         if(len > end - beg - 8)
+            Core::Error({}, mod.name, ": truncated chunk ", std::string{data + beg, 4});
+
+         chunks.push_back({data + beg, data + beg + 8, len});
+         beg += 8 + len;
+      }
+
+      return chunks;
+   }
+
+   //
+   // IsChunk
+   //
+   static bool IsChunk(Chunk const &chunk, char const *name)
+   {
+      return !std::memcmp(chunk.name, name, 4);
+   }
+
+   //
+   // ModuleName
+   //
+   static std::string ModuleName(char const *filename)
+   {
+      std::string name = Core::PathFilename(filename);
+
+      auto dot = name.rfind('.');
+      if(dot != std::string::npos && dot != 0)
+         name.erase(dot);
+
+      return name;
+   }
+
+   //
+   // NameEqual
+   //
+   static bool NameEqual(std::string const &l, std::string const &r)
+   {
+      return l.size() == r.size() && std::equal(l.begin(), l.end(), r.begin(),
+         [](char a, char b) {return std::toupper(a) == std::toupper(b);});
+   }
+
+   //
+   // Unescape
+   //
+   // Reverses the escapes used when writing strings.
+   //
+   static std::string Unescape(std::string const &str)
+   {
+      std::string out;
+      out.reserve(str.size());
+
+      for(std::size_t i = 0, e = str.size(); i != e; ++i)
+      {
+         if(str[i] != '\\' || i + 1 == e)
+         {
+            out += str[i];
+            continue;
+         }
+
+         if(str[++i] == '0')
+         {
+            out += '\0';
+
+            if(i + 2 < e && str[i + 1] == '0' && str[i + 2] == '0')
+               i += 2;
+         }
+         else
+            out += str[i];
+      }
+
+      return out;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // ChunkReader::get
+   //
+   char const *ChunkReader::get(std::size_t len)
+   {
+      if(len > chunk.size - pos)
+         ChunkError(mod, chunk.name, "truncated");
+
+      auto p = chunk.data + pos;
+      pos += len;
+      return p;
+   }
+
+   //
+   // ChunkReader::getString
+   //
+   std::string ChunkReader::getString()
+   {
+      auto beg = chunk.data + pos;
+      auto end = static_cast<char const *>(std::memchr(beg, '\0', chunk.size - pos));
+
+      if(!end)
+         ChunkError(mod, chunk.name, "unterminated string");
+
+      pos += end - beg + 1;
+      return Unescape({beg, end});
+   }
+
+   //
+   // ChunkReader::getString
+   //
+   std::string ChunkReader::getString(std::size_t offset, Word key, bool encrypted)
+   {
+      std::string str;
+
+      for(std::size_t i = 0;; ++i)
+      {
+         if(offset + i >= chunk.size)
+            ChunkError(mod, chunk.name, "unterminated string");
+
+         char c = chunk.data[offset + i];
+         if(encrypted)
+            c = static_cast<char>(c ^ (i / 2 + key));
+
+         if(!c) break;
+         str += c;
+      }
+
+      return Unescape(str);
+   }
+
+   //
+   // ChunkReader::getStrTab
+   //
+   std::vector<std::string> ChunkReader::getStrTab(bool junk)
+   {
+      if(junk) getWord();
+      auto count = getWord();
+      if(junk) getWord();
+
+      bool encrypted = IsChunk(chunk, "STRE");
+
+      std::vector<std::string> strs;
+      while(count--)
+      {
+         Word offset = getWord();
+         strs.push_back(getString(offset, offset * 157135, encrypted));
+      }
+
+      return strs;
+   }
+
+   //
+   // Module constructor
+   //
+   Module::Module(char const *filename, Word id_) :
+      file{Core::FileOpenBlock(filename)},
+      data{file->data()},
+      size{file->size()},
+      regs(RegMax),
+      regStore(RegMax),
+      name{ModuleName(filename)},
+      id{id_}
+   {
+      auto chunks = GetChunks(*this);
+
+      for(Word i = 0; i != RegMax; ++i)
+         regs[i] = &regStore[i];
+
+      // Functions and scripts.
+      for(auto const &chunk : chunks)
+      {
+         ChunkReader in{*this, chunk};
+
+         if(IsChunk(chunk, "FUNC"))
+         {
+            while(!in.empty())
+            {
+               Function fn;
+               fn.argc   = in.getByte();
+               fn.locals = in.getByte();
+               fn.retn   = in.getByte();
+               in.getByte();
+               fn.addr   = in.getWord();
+               funcs.push_back(std::move(fn));
+            }
+         }
+         else if(IsChunk(chunk, "SPTR"))
+         {
+            bool acs0 = !std::memcmp(data, "ACS\0", 4);
+
+            while(!in.empty())
+            {
+               Script scr;
+               scr.num = static_cast<std::int16_t>(in.getHWord());
+
+               if(acs0)
+               {
+                  scr.type = in.getByte();
+                  scr.argc = in.getByte();
+                  scr.addr = in.getWord();
+               }
+               else
+               {
+                  scr.type = in.getHWord();
+                  scr.addr = in.getWord();
+                  scr.argc = in.getWord();
+               }
+
+               scripts.push_back(std::move(scr));
+            }
+         }
+         else if(IsChunk(chunk, "STRL") || IsChunk(chunk, "STRE"))
+            strings = in.getStrTab(true);
+         else if(IsChunk(chunk, "LOAD"))
+         {
+            while(!in.empty())
+               if(auto load = in.getString(); !load.empty())
+                  loads.push_back(std::move(load));
+         }
+         else if(IsChunk(chunk, "MEXP"))
+            exports = in.getStrTab(false);
+      }
+
+      // Details for functions, scripts, and variables.
+      for(auto const &chunk : chunks)
+      {
+         ChunkReader in{*this, chunk};
+
+         if(IsChunk(chunk, "FNAM"))
+         {
+            auto names = in.getStrTab(false);
+            for(std::size_t i = 0; i != names.size() && i != funcs.size(); ++i)
+               funcs[i].name = std::move(names[i]);
+         }
+         else if(IsChunk(chunk, "SNAM"))
+         {
+            auto names = in.getStrTab(false);
+            for(auto &scr : scripts)
+            {
+               // Named scripts have negative numbers, counting down from -1.
+               if(scr.num < 0 && static_cast<std::size_t>(-1 - scr.num) < names.size())
+                  scr.name = names[-1 - scr.num];
+            }
+         }
+         else if(IsChunk(chunk, "SVCT"))
+         {
+            while(!in.empty())
+            {
+               auto num    = static_cast<std::int16_t>(in.getHWord());
+               auto locals = in.getHWord();
+
+               if(auto scr = findScript(num))
+                  scr->locals = locals;
+            }
+         }
+         else if(IsChunk(chunk, "FARY"))
+         {
+            Word idx = in.getHWord();
+            if(idx >= funcs.size())
+               ChunkError(*this, chunk.name, "bad function");
+
+            while(!in.empty())
+               funcs[idx].arrays.push_back(in.getWord());
+         }
+         else if(IsChunk(chunk, "SARY"))
+         {
+            auto scr = findScript(static_cast<std::int16_t>(in.getHWord()));
+            if(!scr)
+               ChunkError(*this, chunk.name, "bad script");
+
+            while(!in.empty())
+               scr->arrays.push_back(in.getWord());
+         }
+         else if(IsChunk(chunk, "ARAY"))
+         {
+            while(!in.empty())
+            {
+               Word idx = in.getWord();
+               Word len = in.getWord();
+
+               if(idx >= arrStore.size())
+                  arrStore.resize(idx + 1);
+
+               arrStore[idx].resize(len);
+            }
+         }
+         else if(IsChunk(chunk, "MIMP"))
+         {
+            while(!in.empty())
+            {
+               Word idx = in.getWord();
+               importRegs.emplace_back(idx, in.getString());
+            }
+         }
+         else if(IsChunk(chunk, "AIMP"))
+         {
+            for(auto count = in.getWord(); count--;)
+            {
+               Word idx = in.getWord();
+               in.getWord();
+               importArrs.emplace_back(idx, in.getString());
+            }
+         }
+      }
+
+      arrs.resize(arrStore.size());
+      for(std::size_t i = 0; i != arrStore.size(); ++i)
+         arrs[i] = &arrStore[i];
+
+      // Initializers, after all arrays are allocated.
+      for(auto const &chunk : chunks)
+      {
+         ChunkReader in{*this, chunk};
+
+         if(IsChunk(chunk, "MINI"))
+         {
+            for(Word idx = in.getWord(); !in.empty(); ++idx)
+            {
+               if(idx >= RegMax)
+                  ChunkError(*this, chunk.name, "bad variable");
+
+               regStore[idx] = in.getWord();
+            }
+         }
+         else if(IsChunk(chunk, "AINI"))
+         {
+            Word idx = in.getWord();
+            if(idx >= arrStore.size())
+               ChunkError(*this, chunk.name, "bad array");
+
+            for(auto &elem : arrStore[idx])
+            {
+               if(in.empty()) break;
+               elem = in.getWord();
+            }
+         }
+      }
+
+      // Tag strings and function pointers, after initialization.
+      for(auto const &chunk : chunks)
+      {
+         ChunkReader in{*this, chunk};
+
+         if(IsChunk(chunk, "MSTR"))
+         {
+            while(!in.empty())
+            {
+               Word idx = in.getWord();
+               if(idx < RegMax) regStore[idx] |= id;
+            }
+         }
+         else if(IsChunk(chunk, "ASTR"))
+         {
+            while(!in.empty())
+            {
+               Word idx = in.getWord();
+               if(idx < arrStore.size())
+                  for(auto &elem : arrStore[idx]) elem |= id;
+            }
+         }
+         else if(IsChunk(chunk, "ATAG"))
+         {
+            in.getByte();
+            Word idx = in.getWord();
+            if(idx >= arrStore.size())
+               ChunkError(*this, chunk.name, "bad array");
+
+            for(auto &elem : arrStore[idx])
+            {
+               if(in.empty()) break;
+               if(in.getByte()) elem |= id;
+            }
+         }
+      }
+   }
+
+   //
+   // Module destructor
+   //
+   Module::~Module()
+   {
+   }
+
+   //
+   // Module::findFunction
+   //
+   Function *Module::findFunction(std::string const &fnName)
+   {
+      for(auto &fn : funcs)
+         if(fn.addr && fn.name == fnName) return &fn;
+
+      return nullptr;
+   }
+
+   //
+   // Module::findScript
+   //
+   Script *Module::findScript(WordS num)
+   {
+      for(auto &scr : scripts)
+         if(scr.num == num) return &scr;
+
+      return nullptr;
+   }
+
+   //
+   // Module::findScript
+   //
+   Script *Module::findScript(std::string const &scrName)
+   {
+      for(auto &scr : scripts)
+         if(!scr.name.empty() && NameEqual(scr.name, scrName)) return &scr;
+
+      return nullptr;
+   }
+
+   //
+   // Module::link
+   //
+   // Resolves imports from the modules named by LOAD.
+   //
+   void Module::link(std::vector<std::unique_ptr<Module>> const &modules)
+   {
+      std::vector<Module *> libs;
+      for(auto const &load : loads)
+      {
+         auto itr = std::find_if(modules.begin(), modules.end(),
+            [&](std::unique_ptr<Module> const &mod) {return NameEqual(mod->name, load);});
+
+         if(itr == modules.end())
+            Core::Error({}, name, ": library not loaded: ", load);
+
+         libs.push_back(itr->get());
+      }
+
+      // Looks up an export by name.
+      auto findExport = [&](std::string const &exp) -> std::pair<Module *, Word>
+      {
+         for(auto lib : libs)
+         {
+            auto itr = std::find(lib->exports.begin(), lib->exports.end(), exp);
+            if(itr != lib->exports.end())
+               return {lib, static_cast<Word>(itr - lib->exports.begin())};
+         }
+
+         Core::Error({}, name, ": undefined import: ", exp);
+      };
+
+      for(auto &fn : funcs)
+      {
+         if(fn.addr)
+         {
+            fn.implMod = this;
+            fn.impl    = &fn;
+            continue;
+         }
+
+         // Left unresolved, which is an error only if called.
+         for(auto lib : libs)
+         {
+            if(auto impl = lib->findFunction(fn.name))
+            {
+               fn.implMod = lib;
+               fn.impl    = impl;
+               break;
+            }
+         }
+      }
+
+      for(auto const &imp : importRegs)
+      {
+         auto [lib, idx] = findExport(imp.second);
+
+         if(imp.first >= RegMax || idx >= RegMax)
+            Core::Error({}, name, ": bad variable import: ", imp.second);
+
+         regs[imp.first] = &lib->regStore[idx];
+      }
+
+      for(auto const &imp : importArrs)
+      {
+         auto [lib, idx] = findExport(imp.second);
+
+         if(idx >= lib->arrStore.size())
+            Core::Error({}, name, ": bad array import: ", imp.second);
+
+         if(imp.first >= arrs.size())
+            arrs.resize(imp.first + 1, nullptr);
+
+         arrs[imp.first] = &lib->arrStore[idx];
+      }
+   }
+}
+
+// EOF
+
@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS module loading.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACSVM__Module_H__
+#define GDCC__ACSVM__Module_H__
+
+#include "../ACSVM/Types.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // Profile
+   //
+   class Profile
+   {
+   public:
+      std::uint64_t calls  = 0;
+      std::uint64_t instrs = 0;
+   };
+
+   //
+   // Function
+   //
+   class Function
+   {
+   public:
+      std::vector<Word> arrays; // Local array sizes.
+      std::string       name;
+      Profile           prof;
+
+      // Definition, which is in another module for imports. Set by linking.
+      Module   *implMod = nullptr;
+      Function *impl    = nullptr;
+
+      Word addr   = 0;
+      Word argc   = 0;
+      Word locals = 0;
+      bool retn   = false;
+   };
+
+   //
+   // Script
+   //
+   class Script
+   {
+   public:
+      std::vector<Word> arrays; // Local array sizes.
+      std::string       name;
+      Profile           prof;
+
+      Word  addr   = 0;
+      Word  argc   = 0;
+      Word  locals = 20;
+      Word  type   = 0;
+      WordS num    = 0;
+   };
+
+   //
+   // Module
+   //
+   // Loads an ACSE module, with or without an ACS0 header in front. Module
+   // variables and arrays are accessed through regs and arrs, which point
+   // into other modules for imports once linked.
+   //
+   class Module
+   {
+   public:
+      Module(char const *filename, Word id);
+      Module(Module const &) = delete;
+      ~Module();
+
+      Function *findFunction(std::string const &name);
+
+      Script *findScript(WordS num);
+      Script *findScript(std::string const &name);
+
+      void link(std::vector<std::unique_ptr<Module>> const &modules);
+
+      std::unique_ptr<Core::FileBlock> file;
+
+      char const *data;
+      std::size_t size;
+
+      std::vector<Function>    funcs;
+      std::vector<Script>      scripts;
+      std::vector<std::string> strings;
+
+      std::vector<std::string> exports; // Variable and array names, by index.
+      std::vector<std::string> loads;   // Imported module names.
+
+      std::vector<std::pair<Word, std::string>> importArrs;
+      std::vector<std::pair<Word, std::string>> importRegs;
+
+      std::vector<std::vector<Word> *> arrs;
+      std::vector<std::vector<Word>>   arrStore;
+      std::vector<Word *>              regs;
+      std::vector<Word>                regStore;
+
+      std::string name;
+
+      // Library ID, used to tag strings and function pointers.
+      Word const id;
+
+
+      static constexpr Word RegMax = 256;
+   };
+}
+
+#endif//GDCC__ACSVM__Module_H__
+
@@ -0,0 +1,122 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS threads.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACSVM__Thread_H__
+#define GDCC__ACSVM__Thread_H__
+
+#include "../ACSVM/Types.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // SparseArray
+   //
+   // Hub and global arrays, which are unbounded. Lower indexes are kept in a
+   // vector, which grows as needed, and others are kept in a map.
+   //
+   class SparseArray
+   {
+   public:
+      Word get(Word idx) const
+      {
+         if(idx < vec.size()) return vec[idx];
+         if(idx < VecMax)     return 0;
+
+         auto itr = map.find(idx);
+         return itr == map.end() ? 0 : itr->second;
+      }
+
+      void set(Word idx, Word val)
+      {
+         if(idx < VecMax)
+         {
+            if(idx >= vec.size())
+               vec.resize(std::max<std::size_t>(idx + 1, vec.size() * 2));
+
+            vec[idx] = val;
+         }
+         else
+            map[idx] = val;
+      }
+
+   private:
+      std::vector<Word>              vec;
+      std::unordered_map<Word, Word> map;
+
+
+      static constexpr Word VecMax = 1 << 24;
+   };
+
+   //
+   // Frame
+   //
+   // A function or script being executed by a thread. The return state is
+   // the caller's.
+   //
+   class Frame
+   {
+   public:
+      Profile    *prof;
+      Module     *retModule;
+      Word        retPC;
+      std::size_t arrBase;
+      std::size_t locBase;
+      bool        discard;
+   };
+
+   //
+   // Thread
+   //
+   class Thread
+   {
+   public:
+      enum class State
+      {
+         Running,
+         Delayed,
+         Done,
+      };
+
+
+      explicit Thread(VM &vm_) : vm{vm_} {}
+
+      Thread(Thread const &) = delete;
+
+      VM &vm;
+
+      std::vector<std::vector<Word>> arrays; // Local arrays.
+      std::vector<Frame>             frames;
+      std::vector<Word>              locals;
+      std::vector<std::string>       print;
+      std::vector<Word>              stack;
+
+      Module *module = nullptr;
+      Script *script = nullptr;
+
+      Word  pc     = 0;
+      Word  result = 0;
+      Word  wake   = 0;
+      State state  = State::Running;
+   };
+}
+
+#endif//GDCC__ACSVM__Thread_H__
+
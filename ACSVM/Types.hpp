@@ -0,0 +1,42 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Common typedefs and class forward declarations.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACSVM__Types_H__
+#define GDCC__ACSVM__Types_H__
+
+#include "../BC/ZDACS/Types.hpp"
+
+#include <cstdint>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   using Word  = std::uint32_t;
+   using WordS = std::int32_t;
+
+   class Frame;
+   class Function;
+   class Host;
+   class Module;
+   class Profile;
+   class Script;
+   class SparseArray;
+   class Thread;
+   class VM;
+}
+
+#endif//GDCC__ACSVM__Types_H__
+
@@ -0,0 +1,353 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS virtual machine.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACSVM/VM.hpp"
+
+#include "ACSVM/Module.hpp"
+
+#include "Core/Exception.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // StartThread
+   //
+   // Sets up a thread's base frame, with arguments in the first locals.
+   //
+   static void StartThread(Thread &thread, Module &mod, Profile &prof, Word addr,
+      std::vector<Word> const &arrays, Word locals, Word const *argv, Word argc)
+   {
+      thread.module = &mod;
+      thread.pc     = addr;
+      thread.wake   = thread.vm.tic;
+
+      thread.locals.assign(std::max(locals, argc), 0);
+      std::copy(argv, argv + std::min<std::size_t>(argc, thread.locals.size()),
+         thread.locals.begin());
+
+      for(auto size : arrays)
+         thread.arrays.emplace_back(size);
+
+      thread.frames.push_back({&prof, nullptr, 0, 0, 0, false});
+
+      ++prof.calls;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // VM constructor
+   //
+   VM::VM(Host &host_) :
+      host{host_},
+      gblReg{},
+      hubReg{},
+      codeCount{},
+      instrs{0},
+      tic{0}
+   {
+   }
+
+   //
+   // VM destructor
+   //
+   VM::~VM()
+   {
+   }
+
+   //
+   // VM::callFunction
+   //
+   Word VM::callFunction(std::string const &name, Word const *argv, Word argc,
+      Word ticMax)
+   {
+      Module *mod;
+      auto    fn = findFunction(name, mod);
+
+      if(!fn)
+         Core::Error({}, "function not found: ", name);
+
+      // Not in the thread list, so that it is not removed when done.
+      Thread thread{*this};
+      StartThread(thread, *mod, fn->prof, fn->addr, fn->arrays, fn->locals, argv, argc);
+
+      exec(thread);
+
+      while(thread.state != Thread::State::Done)
+      {
+         if(tic == ticMax)
+            Core::Error({}, name, ": still running after ", ticMax, " tics");
+
+         runTic();
+
+         if(thread.wake <= tic)
+            exec(thread);
+      }
+
+      return thread.result;
+   }
+
+   //
+   // VM::findFunction
+   //
+   Function *VM::findFunction(std::string const &name, Module *&mod)
+   {
+      for(auto &m : modules)
+      {
+         if(auto fn = m->findFunction(name))
+            return mod = m.get(), fn;
+      }
+
+      return mod = nullptr, nullptr;
+   }
+
+   //
+   // VM::findScript
+   //
+   Script *VM::findScript(WordS num, Module *&mod)
+   {
+      for(auto &m : modules)
+      {
+         if(auto scr = m->findScript(num))
+            return mod = m.get(), scr;
+      }
+
+      return mod = nullptr, nullptr;
+   }
+
+   //
+   // VM::findScript
+   //
+   Script *VM::findScript(std::string const &name, Module *&mod)
+   {
+      for(auto &m : modules)
+      {
+         if(auto scr = m->findScript(name))
+            return mod = m.get(), scr;
+      }
+
+      return mod = nullptr, nullptr;
+   }
+
+   //
+   // VM::findThread
+   //
+   Thread *VM::findThread(Script const *script)
+   {
+      for(auto &thread : threads)
+      {
+         if(thread->script == script && thread->state != Thread::State::Done)
+            return thread.get();
+      }
+
+      return nullptr;
+   }
+
+   //
+   // VM::getString
+   //
+   std::string const *VM::getString(Word str) const
+   {
+      Word lib = str >> 16, idx = str & 0xFFFF;
+
+      if(lib == StrPoolID >> 16)
+         return idx < strPool.size() ? &strPool[idx] : nullptr;
+
+      if(lib < modules.size() && idx < modules[lib]->strings.size())
+         return &modules[lib]->strings[idx];
+
+      return nullptr;
+   }
+
+   //
+   // VM::link
+   //
+   void VM::link()
+   {
+      for(auto &mod : modules)
+         mod->link(modules);
+   }
+
+   //
+   // VM::loadModule
+   //
+   Module &VM::loadModule(char const *filename)
+   {
+      if(modules.size() == StrPoolID >> 16)
+         Core::Error({}, filename, ": too many modules");
+
+      auto id = static_cast<Word>(modules.size()) << 16;
+      modules.emplace_back(new Module{filename, id});
+      return *modules.back();
+   }
+
+   //
+   // VM::putString
+   //
+   Word VM::putString(std::string &&str)
+   {
+      auto itr = strPoolIdx.find(str);
+      if(itr != strPoolIdx.end())
+         return itr->second;
+
+      if(strPool.size() == 0x10000)
+         Core::Error({}, "string pool full");
+
+      auto val = static_cast<Word>(strPool.size()) | StrPoolID;
+      strPool.push_back(str);
+      strPoolIdx.emplace(std::move(str), val);
+
+      return val;
+   }
+
+   //
+   // VM::run
+   //
+   void VM::run(Word ticMax)
+   {
+      while(tic != ticMax && runTic()) {}
+   }
+
+   //
+   // VM::runTic
+   //
+   bool VM::runTic()
+   {
+      // Scripts started during the tic are run in it.
+      for(std::size_t i = 0; i != threads.size(); ++i)
+      {
+         auto &thread = *threads[i];
+
+         if(thread.state != Thread::State::Done && thread.wake <= tic)
+            exec(thread);
+      }
+
+      threads.erase(std::remove_if(threads.begin(), threads.end(),
+         [](std::unique_ptr<Thread> const &thread)
+            {return thread->state == Thread::State::Done;}),
+         threads.end());
+
+      ++tic;
+
+      return !threads.empty();
+   }
+
+   //
+   // VM::startScript
+   //
+   Thread *VM::startScript(Module &mod, Script &scr, Word const *argv, Word argc)
+   {
+      threads.emplace_back(new Thread{*this});
+
+      auto &thread = *threads.back();
+      thread.script = &scr;
+      StartThread(thread, mod, scr.prof, scr.addr, scr.arrays, scr.locals, argv, argc);
+
+      return &thread;
+   }
+
+   //
+   // VM::startScriptsOpen
+   //
+   void VM::startScriptsOpen()
+   {
+      for(auto &mod : modules)
+      {
+         for(auto &scr : mod->scripts)
+         {
+            if(scr.type == 1)
+               startScript(*mod, scr, nullptr, 0);
+         }
+      }
+   }
+
+   //
+   // VM::writeReport
+   //
+   void VM::writeReport(std::ostream &out) const
+   {
+      struct Entry {std::string name; Profile const *prof;};
+
+      std::vector<Entry> entries;
+
+      for(auto const &mod : modules)
+      {
+         for(auto const &fn : mod->funcs)
+         {
+            if(fn.addr && fn.prof.calls)
+               entries.push_back({fn.name, &fn.prof});
+         }
+
+         for(auto const &scr : mod->scripts)
+         {
+            if(scr.prof.calls)
+               entries.push_back({scr.name.empty() ? "script " +
+                  std::to_string(scr.num) : "script \"" + scr.name + '"', &scr.prof});
+         }
+      }
+
+      std::stable_sort(entries.begin(), entries.end(),
+         [](Entry const &l, Entry const &r)
+            {return l.prof->instrs > r.prof->instrs;});
+
+      out << "instructions: " << instrs << '\n'
+          << "tics: " << tic << '\n'
+          << "threads running: " << threads.size() << "\n\n";
+
+      out << std::setw(12) << "instrs" << ' ' << std::setw(10) << "calls"
+          << "  function\n";
+
+      for(auto const &entry : entries)
+      {
+         out << std::setw(12) << entry.prof->instrs << ' '
+             << std::setw(10) << entry.prof->calls << "  " << entry.name << '\n';
+      }
+
+      std::vector<Word> codes;
+      for(Word code = 0; code <= CodeMax; ++code)
+         if(codeCount[code]) codes.push_back(code);
+
+      std::stable_sort(codes.begin(), codes.end(),
+         [&](Word l, Word r) {return codeCount[l] > codeCount[r];});
+
+      out << '\n' << std::setw(12) << "count" << "  instruction\n";
+
+      for(auto code : codes)
+      {
+         out << std::setw(12) << codeCount[code] << "  ";
+
+         if(auto name = GetCodeName(code))
+            out << name;
+         else
+            out << code;
+
+         out << '\n';
+      }
+   }
+}
+
+// EOF
+
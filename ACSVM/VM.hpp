@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS virtual machine.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACSVM__VM_H__
+#define GDCC__ACSVM__VM_H__
+
+#include "../ACSVM/Code.hpp"
+#include "../ACSVM/Thread.hpp"
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // VM
+   //
+   // Runs ACS modules without an engine, counting every instruction executed
+   // by code and by function or script. Modules are loaded in order, with the
+   // first as the main module, and then linked.
+   //
+   class VM
+   {
+   public:
+      explicit VM(Host &host);
+      VM(VM const &) = delete;
+      ~VM();
+
+      // Runs a function to completion, for up to ticMax tics, and returns
+      // its result. Other threads run while it is delayed.
+      Word callFunction(std::string const &name, Word const *argv, Word argc,
+         Word ticMax);
+
+      void exec(Thread &thread);
+
+      Function *findFunction(std::string const &name, Module *&mod);
+
+      Script *findScript(WordS num, Module *&mod);
+      Script *findScript(std::string const &name, Module *&mod);
+
+      Thread *findThread(Script const *script);
+
+      std::string const *getString(Word str) const;
+
+      void link();
+
+      Module &loadModule(char const *filename);
+
+      Word putString(std::string &&str);
+
+      // Runs threads for up to ticMax tics, or until none remain.
+      void run(Word ticMax);
+
+      // Runs one tic. Returns true if any threads remain.
+      bool runTic();
+
+      Thread *startScript(Module &mod, Script &scr, Word const *argv, Word argc);
+
+      // Starts every open script.
+      void startScriptsOpen();
+
+      void writeReport(std::ostream &out) const;
+
+      Host &host;
+
+      std::vector<std::unique_ptr<Module>> modules;
+      std::vector<std::unique_ptr<Thread>> threads;
+
+      SparseArray gblArr[64];
+      Word        gblReg[64];
+      SparseArray hubArr[64];
+      Word        hubReg[64];
+
+      std::uint64_t codeCount[CodeMax + 1];
+      std::uint64_t instrs;
+
+      Word tic;
+
+
+      // Library ID for strings made at runtime.
+      static constexpr Word StrPoolID = 0x7FFF << 16;
+
+   private:
+      std::vector<std::string>              strPool;
+      std::unordered_map<std::string, Word> strPoolIdx;
+   };
+}
+
+#endif//GDCC__ACSVM__VM_H__
+
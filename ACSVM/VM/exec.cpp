@@ -0,0 +1,606 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ACS instruction execution.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACSVM/VM.hpp"
+
+#include "ACSVM/Host.hpp"
+#include "ACSVM/Module.hpp"
+
+#include "Core/Exception.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::ACSVM
+{
+   static constexpr std::size_t FrameMax = 0x10000;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // ExecError
+   //
+   template<typename... Args>
+   [[noreturn]] static void ExecError(Module const *mod, Word pc, Args const &...args)
+   {
+      Core::Error({}, mod->name, ':', pc, ": ", args...);
+   }
+
+   //
+   // ReadWord
+   //
+   static Word ReadWord(Module const *mod, Word pos)
+   {
+      if(pos > mod->size || mod->size - pos < 4)
+         ExecError(mod, pos, "code out of bounds");
+
+      auto p = reinterpret_cast<unsigned char const *>(mod->data + pos);
+      return p[0] | p[1] << 8 | p[2] << 16 | static_cast<Word>(p[3]) << 24;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACSVM
+{
+   //
+   // VM::exec
+   //
+   // Runs the thread until it ends or is delayed. The semantics follow ZDoom,
+   // except that invalid register indexes and division by zero are errors.
+   //
+   void VM::exec(Thread &thread)
+   {
+      auto &stk  = thread.stack;
+      auto  mod  = thread.module;
+      auto  pc   = thread.pc;
+      auto  prof = thread.frames.back().prof;
+      auto  loc  = thread.frames.back().locBase;
+      auto  arr  = thread.frames.back().arrBase;
+      Word  op   = pc; // Start of current instruction, for errors.
+
+      thread.state = Thread::State::Running;
+
+      auto error = [&](auto const &...args)
+         {ExecError(mod, op, args...);};
+
+      auto arg = [&]() -> Word {auto w = ReadWord(mod, pc); pc += 4; return w;};
+
+      auto pop = [&]() -> Word
+      {
+         if(stk.empty()) error("stack underflow");
+         auto w = stk.back(); stk.pop_back(); return w;
+      };
+
+      auto top = [&]() -> Word &
+      {
+         if(stk.empty()) error("stack underflow");
+         return stk.back();
+      };
+
+      auto popArgs = [&](Word *argv, Word argc)
+      {
+         if(stk.size() < argc) error("stack underflow");
+         std::copy(stk.end() - argc, stk.end(), argv);
+         stk.resize(stk.size() - argc);
+      };
+
+      // Saves state for the host, which may look at or run threads.
+      auto sync = [&]() {thread.module = mod; thread.pc = pc;};
+
+      auto finish = [&]()
+      {
+         thread.state = Thread::State::Done;
+         thread.arrays.clear();
+         thread.frames.clear();
+         thread.locals.clear();
+         sync();
+      };
+
+      auto getLocReg = [&]() -> Word &
+      {
+         auto idx = arg();
+         if(idx >= thread.locals.size() - loc) error("bad local register ", idx);
+         return thread.locals[loc + idx];
+      };
+
+      auto getModReg = [&]() -> Word &
+      {
+         auto idx = arg();
+         if(idx >= Module::RegMax) error("bad module register ", idx);
+         return *mod->regs[idx];
+      };
+
+      auto getHubReg = [&]() -> Word &
+      {
+         auto idx = arg();
+         if(idx >= 64) error("bad hub register ", idx);
+         return hubReg[idx];
+      };
+
+      auto getGblReg = [&]() -> Word &
+      {
+         auto idx = arg();
+         if(idx >= 64) error("bad global register ", idx);
+         return gblReg[idx];
+      };
+
+      auto getLocArr = [&]() -> std::vector<Word> &
+      {
+         auto idx = arg();
+         if(idx >= thread.arrays.size() - arr) error("bad local array ", idx);
+         return thread.arrays[arr + idx];
+      };
+
+      auto getModArr = [&]() -> std::vector<Word> &
+      {
+         auto idx = arg();
+         if(idx >= mod->arrs.size() || !mod->arrs[idx]) error("bad module array ", idx);
+         return *mod->arrs[idx];
+      };
+
+      auto getHubArr = [&]() -> SparseArray &
+      {
+         auto idx = arg();
+         if(idx >= 64) error("bad hub array ", idx);
+         return hubArr[idx];
+      };
+
+      auto getGblArr = [&]() -> SparseArray &
+      {
+         auto idx = arg();
+         if(idx >= 64) error("bad global array ", idx);
+         return gblArr[idx];
+      };
+
+      auto getPrint = [&]() -> std::string &
+      {
+         if(thread.print.empty()) error("print not started");
+         return thread.print.back();
+      };
+
+      auto endPrint = [&]() -> std::string
+      {
+         auto str = std::move(getPrint());
+         thread.print.pop_back();
+         return str;
+      };
+
+      auto call = [&](Function &fn, bool discard)
+      {
+         if(!fn.impl) error("undefined function: ", fn.name);
+         if(thread.frames.size() == FrameMax) error("call stack overflow");
+
+         auto &impl = *fn.impl;
+         auto  argc = impl.argc;
+
+         if(stk.size() < argc) error("stack underflow");
+
+         auto locNew = thread.locals.size();
+         thread.locals.resize(locNew + std::max(impl.locals, argc));
+         std::copy(stk.end() - argc, stk.end(), thread.locals.begin() + locNew);
+         stk.resize(stk.size() - argc);
+
+         auto arrNew = thread.arrays.size();
+         for(auto size : impl.arrays)
+            thread.arrays.emplace_back(size);
+
+         thread.frames.push_back({&impl.prof, mod, pc, arrNew, locNew, discard});
+
+         mod  = fn.implMod;
+         pc   = impl.addr;
+         prof = &impl.prof;
+         loc  = locNew;
+         arr  = arrNew;
+
+         ++prof->calls;
+      };
+
+      // Returns false if the thread ended.
+      auto retn = [&](Word val) -> bool
+      {
+         if(thread.frames.size() == 1)
+         {
+            thread.result = val;
+            finish();
+            return false;
+         }
+
+         auto frame = thread.frames.back();
+         thread.frames.pop_back();
+         thread.locals.resize(frame.locBase);
+         thread.arrays.resize(frame.arrBase);
+
+         mod  = frame.retModule;
+         pc   = frame.retPC;
+         prof = thread.frames.back().prof;
+         loc  = thread.frames.back().locBase;
+         arr  = thread.frames.back().arrBase;
+
+         if(!frame.discard)
+            stk.push_back(val);
+
+         return true;
+      };
+
+      // Returns false if the thread was delayed.
+      auto delay = [&](Word tics) -> bool
+      {
+         if(static_cast<WordS>(tics) <= 0)
+            return true;
+
+         thread.state = Thread::State::Delayed;
+         thread.wake  = tic + tics;
+         sync();
+         return false;
+      };
+
+      auto binary = [&](auto fn) {auto r = pop(); auto &l = top(); l = fn(l, r);};
+
+      auto divide = [&](bool mod_)
+      {
+         auto r = static_cast<WordS>(pop());
+         auto l = static_cast<WordS>(top());
+
+         if(r == 0) error("division by zero");
+
+         if(r == -1)
+            top() = mod_ ? 0 : 0 - static_cast<Word>(l);
+         else
+            top() = static_cast<Word>(mod_ ? l % r : l / r);
+      };
+
+      auto printCharArray = [&](bool range)
+      {
+         WordS cap = 0x7FFFFFFF, off = 0;
+
+         if(range)
+         {
+            cap = static_cast<WordS>(pop());
+            off = static_cast<WordS>(pop());
+         }
+
+         auto idx  = pop();
+         auto base = pop();
+         auto &buf = getPrint();
+
+         if(idx >= 64) error("bad global array ", idx);
+         if(cap < 1 || off < 0) return;
+
+         for(Word i = base + off; cap--; ++i)
+         {
+            auto c = gblArr[idx].get(i);
+            if(!c) break;
+            buf += static_cast<char>(c);
+         }
+      };
+
+      for(;;)
+      {
+         op = pc;
+
+         auto code = arg();
+
+         ++instrs;
+         ++prof->instrs;
+         ++codeCount[std::min(code, CodeMax)];
+
+         switch(static_cast<Code>(code))
+         {
+         case Code::Nop: break;
+
+         case Code::Rscr: finish(); return;
+
+         case Code::Push_Lit: stk.push_back(arg()); break;
+
+         case Code::Cspe_1:
+         case Code::Cspe_2:
+         case Code::Cspe_3:
+         case Code::Cspe_4:
+         case Code::Cspe_5:
+         {
+            Word argv[5], argc = code - static_cast<Word>(Code::Cspe_1) + 1;
+            auto spec = arg();
+            popArgs(argv, argc);
+            sync();
+            host.callSpec(thread, spec, argv, argc);
+         }
+            break;
+
+         case Code::Cspe_1L:
+         case Code::Cspe_2L:
+         case Code::Cspe_3L:
+         case Code::Cspe_4L:
+         case Code::Cspe_5L:
+         {
+            Word argv[5], argc = code - static_cast<Word>(Code::Cspe_1L) + 1;
+            auto spec = arg();
+            for(Word i = 0; i != argc; ++i) argv[i] = arg();
+            sync();
+            host.callSpec(thread, spec, argv, argc);
+         }
+            break;
+
+         case Code::Cspe_5R1:
+         {
+            Word argv[5];
+            auto spec = arg();
+            popArgs(argv, 5);
+            sync();
+            stk.push_back(host.callSpec(thread, spec, argv, 5));
+         }
+            break;
+
+         case Code::Cnat:
+         {
+            auto argc = arg();
+            auto func = arg();
+
+            if(stk.size() < argc) error("stack underflow");
+            std::vector<Word> argv{stk.end() - argc, stk.end()};
+            stk.resize(stk.size() - argc);
+
+            sync();
+            stk.push_back(host.callFunc(thread, func, argv.data(), argc));
+         }
+            break;
+
+         case Code::AddU: binary([](Word l, Word r) {return l + r;}); break;
+         case Code::SubU: binary([](Word l, Word r) {return l - r;}); break;
+         case Code::MulU: binary([](Word l, Word r) {return l * r;}); break;
+         case Code::DivI: divide(false); break;
+         case Code::ModI: divide(true);  break;
+
+         case Code::MulX:
+            binary([](Word l, Word r) {return static_cast<Word>(
+               static_cast<std::int64_t>(static_cast<WordS>(l)) *
+               static_cast<WordS>(r) >> 16);});
+            break;
+
+         case Code::DivX:
+         {
+            auto r = static_cast<WordS>(pop());
+            if(r == 0) error("division by zero");
+            top() = static_cast<Word>(
+               static_cast<std::int64_t>(static_cast<WordS>(top())) * 0x10000 / r);
+         }
+            break;
+
+         case Code::CmpU_EQ: binary([](Word l, Word r) -> Word {return l == r;}); break;
+         case Code::CmpU_NE: binary([](Word l, Word r) -> Word {return l != r;}); break;
+         case Code::CmpI_LT: binary([](Word l, Word r) -> Word {return static_cast<WordS>(l) <  static_cast<WordS>(r);}); break;
+         case Code::CmpI_GT: binary([](Word l, Word r) -> Word {return static_cast<WordS>(l) >  static_cast<WordS>(r);}); break;
+         case Code::CmpI_LE: binary([](Word l, Word r) -> Word {return static_cast<WordS>(l) <= static_cast<WordS>(r);}); break;
+         case Code::CmpI_GE: binary([](Word l, Word r) -> Word {return static_cast<WordS>(l) >= static_cast<WordS>(r);}); break;
+
+         case Code::LAnd: binary([](Word l, Word r) -> Word {return l && r;}); break;
+         case Code::LOrI: binary([](Word l, Word r) -> Word {return l || r;}); break;
+         case Code::BAnd: binary([](Word l, Word r) {return l & r;}); break;
+         case Code::BOrI: binary([](Word l, Word r) {return l | r;}); break;
+         case Code::BOrX: binary([](Word l, Word r) {return l ^ r;}); break;
+         case Code::ShLU: binary([](Word l, Word r) {return l << (r & 31);}); break;
+         case Code::ShRI: binary([](Word l, Word r) {return static_cast<Word>(static_cast<WordS>(l) >> (r & 31));}); break;
+
+         case Code::LNot: top() = !top(); break;
+         case Code::BNot: top() = ~top(); break;
+         case Code::NegI: top() = 0 - top(); break;
+
+         case Code::Drop_LocReg: {auto &r = getLocReg(); r = pop();} break;
+         case Code::Drop_ModReg: {auto &r = getModReg(); r = pop();} break;
+         case Code::Drop_HubReg: {auto &r = getHubReg(); r = pop();} break;
+         case Code::Drop_GblReg: {auto &r = getGblReg(); r = pop();} break;
+
+         case Code::Push_LocReg: stk.push_back(getLocReg()); break;
+         case Code::Push_ModReg: stk.push_back(getModReg()); break;
+         case Code::Push_HubReg: stk.push_back(getHubReg()); break;
+         case Code::Push_GblReg: stk.push_back(getGblReg()); break;
+
+         case Code::AddU_LocReg: {auto &r = getLocReg(); r += pop();} break;
+         case Code::AddU_ModReg: {auto &r = getModReg(); r += pop();} break;
+         case Code::AddU_HubReg: {auto &r = getHubReg(); r += pop();} break;
+         case Code::AddU_GblReg: {auto &r = getGblReg(); r += pop();} break;
+
+         case Code::SubU_LocReg: {auto &r = getLocReg(); r -= pop();} break;
+         case Code::SubU_ModReg: {auto &r = getModReg(); r -= pop();} break;
+         case Code::SubU_HubReg: {auto &r = getHubReg(); r -= pop();} break;
+         case Code::SubU_GblReg: {auto &r = getGblReg(); r -= pop();} break;
+
+         case Code::IncU_LocReg: ++getLocReg(); break;
+         case Code::IncU_ModReg: ++getModReg(); break;
+         case Code::IncU_HubReg: ++getHubReg(); break;
+         case Code::IncU_GblReg: ++getGblReg(); break;
+
+         case Code::DecU_LocReg: --getLocReg(); break;
+         case Code::DecU_ModReg: --getModReg(); break;
+         case Code::DecU_HubReg: --getHubReg(); break;
+         case Code::DecU_GblReg: --getGblReg(); break;
+
+         case Code::Push_LocArr: {auto &a = getLocArr(); auto &i = top(); i = i < a.size() ? a[i] : 0;} break;
+         case Code::Push_ModArr: {auto &a = getModArr(); auto &i = top(); i = i < a.size() ? a[i] : 0;} break;
+         case Code::Push_HubArr: {auto &a = getHubArr(); auto &i = top(); i = a.get(i);} break;
+         case Code::Push_GblArr: {auto &a = getGblArr(); auto &i = top(); i = a.get(i);} break;
+
+         case Code::Drop_LocArr: {auto &a = getLocArr(); auto v = pop(), i = pop(); if(i < a.size()) a[i] = v;} break;
+         case Code::Drop_ModArr: {auto &a = getModArr(); auto v = pop(), i = pop(); if(i < a.size()) a[i] = v;} break;
+         case Code::Drop_HubArr: {auto &a = getHubArr(); auto v = pop(), i = pop(); a.set(i, v);} break;
+         case Code::Drop_GblArr: {auto &a = getGblArr(); auto v = pop(), i = pop(); a.set(i, v);} break;
+
+         case Code::Jump_Lit: pc = arg(); break;
+
+         case Code::Jcnd_Tru: {auto addr = arg(); if( pop()) pc = addr;} break;
+         case Code::Jcnd_Nil: {auto addr = arg(); if(!pop()) pc = addr;} break;
+
+         case Code::Jcnd_Lit:
+         {
+            auto val  = arg();
+            auto addr = arg();
+            if(top() == val) {stk.pop_back(); pc = addr;}
+         }
+            break;
+
+         case Code::Jcnd_Tab:
+         {
+            // Cases are sorted by value as signed.
+            auto count = arg();
+            auto val   = static_cast<WordS>(top());
+            auto tab   = pc;
+
+            if(count > (mod->size - tab) / 8) error("case table out of bounds");
+            pc += count * 8;
+
+            for(Word lo = 0, hi = count; lo != hi;)
+            {
+               Word mid = lo + (hi - lo) / 2;
+               auto key = static_cast<WordS>(ReadWord(mod, tab + mid * 8));
+
+               if(key == val) {stk.pop_back(); pc = ReadWord(mod, tab + mid * 8 + 4); break;}
+               if(key < val) lo = mid + 1; else hi = mid;
+            }
+         }
+            break;
+
+         case Code::Jdyn: pc = pop(); break;
+
+         case Code::Drop_Nul: pop(); break;
+         case Code::Copy: {auto w = top(); stk.push_back(w);} break;
+         case Code::Swap:
+            if(stk.size() < 2) error("stack underflow");
+            std::swap(stk.end()[-1], stk.end()[-2]);
+            break;
+
+         case Code::Wait_Lit: if(!delay(arg())) return; break;
+
+         case Code::Call_Lit:
+         case Code::Call_Nul:
+         {
+            auto idx = arg();
+            if(idx >= mod->funcs.size()) error("bad function ", idx);
+            call(mod->funcs[idx], code == static_cast<Word>(Code::Call_Nul));
+         }
+            break;
+
+         case Code::Call_Stk:
+         {
+            auto val = pop();
+            Word lib = val >> 16, idx = val & 0xFFFF;
+            if(lib >= modules.size() || idx >= modules[lib]->funcs.size())
+               error("bad function pointer ", val);
+            call(modules[lib]->funcs[idx], false);
+         }
+            break;
+
+         case Code::Retn_Nul: if(!retn(0))     return; break;
+         case Code::Retn_Stk: if(!retn(pop())) return; break;
+
+         case Code::Pfun_Lit: stk.push_back(arg() | mod->id); break;
+
+         case Code::Pstr_Stk:
+         {
+            auto str = pop();
+            sync();
+            stk.push_back(host.tagString(thread, str));
+         }
+            break;
+
+         case Code::Drop_ScrRet: thread.result = pop(); break;
+
+         default:
+            // Engine instructions, which are not in Code.
+            switch(code)
+            {
+            case CodeExt::Delay: if(!delay(pop())) return; break;
+
+            case CodeExt::BeginPrint: thread.print.emplace_back(); break;
+
+            case CodeExt::PrintString:
+            {
+               auto str = getString(pop());
+               auto &buf = getPrint();
+               if(str) buf += *str;
+            }
+               break;
+
+            case CodeExt::PrintNumber:
+               getPrint() += std::to_string(static_cast<WordS>(pop()));
+               break;
+
+            case CodeExt::PrintChar:
+               getPrint() += static_cast<char>(pop());
+               break;
+
+            case CodeExt::PrintFixed:
+            case CodeExt::PrintHex:
+            {
+               char buf[32];
+               auto val = pop();
+
+               if(code == CodeExt::PrintHex)
+                  std::snprintf(buf, sizeof(buf), "%X", static_cast<unsigned>(val));
+               else
+                  std::snprintf(buf, sizeof(buf), "%g", static_cast<WordS>(val) / 65536.0);
+
+               getPrint() += buf;
+            }
+               break;
+
+            case CodeExt::PrintGlobalCharArray: printCharArray(false); break;
+            case CodeExt::PrintGlobalCharRange: printCharArray(true);  break;
+
+            case CodeExt::EndPrint:
+            case CodeExt::EndPrintBold:
+            case CodeExt::EndLog:
+            {
+               auto str = endPrint();
+               sync();
+               host.print(thread, str);
+            }
+               break;
+
+            case CodeExt::EndStrParam: stk.push_back(putString(endPrint())); break;
+
+            case CodeExt::StrLen:
+            {
+               auto str = getString(top());
+               top() = str ? static_cast<Word>(str->size()) : 0;
+            }
+               break;
+
+            case CodeExt::Timer: stk.push_back(tic); break;
+
+            default:
+               if(auto name = GetCodeName(code))
+                  error("unsupported instruction ", name);
+               else
+                  error("unsupported instruction ", code);
+            }
+            break;
+         }
+      }
+   }
+}
+
+// EOF
+
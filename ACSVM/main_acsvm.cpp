@@ -0,0 +1,215 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Program entry point.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACSVM/Host.hpp"
+#include "ACSVM/Module.hpp"
+#include "ACSVM/VM.hpp"
+
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+
+#include "Option/CStr.hpp"
+#include "Option/CStrV.hpp"
+#include "Option/Int.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+//
+// --arg
+//
+static GDCC::Option::CStrV Arg
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("arg")
+      .setGroup("input")
+      .setDescS("Adds an argument for --call or --script."),
+
+   1
+};
+
+//
+// --call
+//
+static GDCC::Option::CStr CallFunction
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("call")
+      .setGroup("input")
+      .setDescS("Calls a function by name.")
+      .setDescL("Calls a function by name, after the first tic, and prints "
+         "its result. The name is as in the module, so C functions have a "
+         "leading underscore. Arguments are passed as given, and functions "
+         "using GDCC's StdCall convention take the auto stack pointer as "
+         "their first argument.")
+};
+
+//
+// --script
+//
+static GDCC::Option::CStr StartScript
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("script")
+      .setGroup("input")
+      .setDescS("Starts a script by number or name.")
+      .setDescL("Starts a script by number or name, along with the open "
+         "scripts.")
+};
+
+//
+// --tics
+//
+static GDCC::Option::Int<unsigned> Tics
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("tics")
+      .setGroup("input")
+      .setDescS("Sets the number of tics to run.")
+      .setDescL("Sets the number of tics to run before stopping scripts "
+         "that are still running. Default is 350."),
+
+   350
+};
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+//
+// GetArgs
+//
+static std::vector<GDCC::ACSVM::Word> GetArgs()
+{
+   std::vector<GDCC::ACSVM::Word> args;
+
+   for(auto arg : Arg)
+   {
+      char *end;
+      auto  val = std::strtol(arg, &end, 0);
+
+      if(*end || end == arg)
+         GDCC::Core::Error({}, "invalid argument: ", arg);
+
+      args.push_back(static_cast<GDCC::ACSVM::Word>(val));
+   }
+
+   return args;
+}
+
+//
+// MakeACSVM
+//
+static void MakeACSVM()
+{
+   using namespace GDCC::ACSVM;
+
+   auto const &inputs = GDCC::Core::GetOptionArgs();
+   if(!inputs.size())
+      GDCC::Core::Error({}, "no modules");
+
+   Host host;
+   VM   vm{host};
+
+   for(auto const &input : inputs)
+      vm.loadModule(input);
+
+   vm.link();
+
+   auto args = GetArgs();
+
+   vm.startScriptsOpen();
+
+   if(StartScript.data())
+   {
+      Module *mod;
+      Script *scr;
+
+      char *end;
+      auto  num = std::strtol(StartScript.data(), &end, 0);
+
+      if(*end || end == StartScript.data())
+         scr = vm.findScript(std::string{StartScript.data()}, mod);
+      else
+         scr = vm.findScript(static_cast<WordS>(num), mod);
+
+      if(!scr)
+         GDCC::Core::Error({}, "script not found: ", StartScript.data());
+
+      vm.startScript(*mod, *scr, args.data(), args.size());
+   }
+
+   if(CallFunction.data())
+   {
+      vm.runTic();
+
+      auto result = vm.callFunction(CallFunction.data(), args.data(), args.size(), Tics);
+      std::cout << CallFunction.data() << " returned " << static_cast<WordS>(result) << '\n';
+   }
+
+   vm.run(Tics);
+
+   auto outName = GDCC::Core::GetOptionOutput();
+   if(!outName) outName = "-";
+
+   auto buf = GDCC::Core::FileOpenStream(outName, std::ios_base::out);
+   std::ostream out{buf.get()};
+   vm.writeReport(out);
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+//
+// main
+//
+int main(int argc, char *argv[])
+{
+   auto &opts = GDCC::Core::GetOptions();
+
+   opts.list.name     = "gdcc-acsvm";
+   opts.list.nameFull = "GDCC ACS Virtual Machine";
+
+   opts.list.usage = "[option]... [module]...";
+
+   opts.list.descS =
+      "Runs ACSE modules without an engine and writes instruction counts by "
+      "function and by instruction. The first module is the main module, "
+      "and libraries it loads must follow it. Output defaults to stdout.";
+
+   try
+   {
+      GDCC::Core::ProcessOptions(opts, argc, argv, false);
+      MakeACSVM();
+   }
+   catch(std::exception const &e)
+   {
+      std::cerr << "ERROR: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+   }
+   catch(int e)
+   {
+      return e;
+   }
+}
+
+// EOF
+
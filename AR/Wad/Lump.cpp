@@ -18,6 +18,7 @@
 #include "Core/File.hpp"
 #include "Core/Path.hpp"
 
+#include <sstream>
 #include <string>
 
 
@@ -46,6 +47,29 @@ namespace GDCC::AR::Wad
       ListUtil::Unlink(this);
    }
 
+   //
+   // Lump::getData
+   //
+   char const *Lump::getData(std::unique_ptr<Core::FileBlock> &) const
+   {
+      return nullptr;
+   }
+
+   //
+   // Lump::getHash
+   //
+   std::size_t Lump::getHash() const
+   {
+      if(!cacheHash)
+      {
+         std::unique_ptr<Core::FileBlock> buf;
+         if(auto data = getData(buf))
+            cacheHash = Core::StrHash(data, sizeData());
+      }
+
+      return cacheHash;
+   }
+
    //
    // Lump::sizeHead
    //
@@ -55,6 +79,18 @@ namespace GDCC::AR::Wad
       return 1;
    }
 
+   //
+   // Lump::writeDataAt
+   //
+   void Lump::writeDataAt(Core::FileOutput &out, std::size_t pos) const
+   {
+      std::ostringstream buf;
+      writeData(buf);
+
+      auto data = buf.str();
+      out.write(pos, data.data(), data.size());
+   }
+
    //
    // Lump::writeDirs
    //
@@ -63,10 +99,25 @@ namespace GDCC::AR::Wad
       Core::PathRestore pathRestore{path};
 
       Core::PathAppend(path, GetFileFromName(name));
-      auto buf = Core::FileOpenStream(path.data(),
-         std::ios_base::out | std::ios_base::binary);
-      std::ostream out{buf.get()};
-      writeData(out);
+      writeFile(path.data());
+   }
+
+   //
+   // Lump::writeFile
+   //
+   void Lump::writeFile(char const *filename) const
+   {
+      if(auto file = Core::FileOpenOutput(filename))
+      {
+         writeDataAt(*file, 0);
+      }
+      else
+      {
+         auto buf = Core::FileOpenStream(filename,
+            std::ios_base::out | std::ios_base::binary);
+         std::ostream out{buf.get()};
+         writeData(out);
+      }
    }
 
    //
@@ -98,6 +149,14 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_Data::getData
+   //
+   char const *Lump_Data::getData(std::unique_ptr<Core::FileBlock> &) const
+   {
+      return data.get();
+   }
+
    //
    // Lump_Data::sizeData
    //
@@ -114,6 +173,14 @@ namespace GDCC::AR::Wad
       out.write(data.get(), size);
    }
 
+   //
+   // Lump_Data::writeDataAt
+   //
+   void Lump_Data::writeDataAt(Core::FileOutput &out, std::size_t pos) const
+   {
+      out.write(pos, data.get(), size);
+   }
+
    //
    // Lump_Empty::sizeData
    //
@@ -139,6 +206,20 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_File::getData
+   //
+   char const *Lump_File::getData(std::unique_ptr<Core::FileBlock> &buf) const
+   {
+      buf = Core::FileOpenBlock(file.get());
+
+      // The file changed since it was added, so leave it to writeData.
+      if(buf->size() != size)
+         return nullptr;
+
+      return buf->data();
+   }
+
    //
    // Lump_File::sizeData
    //
@@ -152,9 +233,16 @@ namespace GDCC::AR::Wad
    //
    void Lump_File::writeData(std::ostream &out) const
    {
-      auto in = Core::FileOpenStream(file.get(), std::ios_base::in | std::ios_base::binary);
-      for(int c; (c = in->sbumpc()) != EOF;)
-         out.put(c);
+      auto in = Core::FileOpenBlock(file.get());
+      out.write(in->data(), in->size());
+   }
+
+   //
+   // Lump_File::writeDataAt
+   //
+   void Lump_File::writeDataAt(Core::FileOutput &out, std::size_t pos) const
+   {
+      out.writeFile(pos, file.get(), size);
    }
 
    //
@@ -176,6 +264,14 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_FilePart::getData
+   //
+   char const *Lump_FilePart::getData(std::unique_ptr<Core::FileBlock> &) const
+   {
+      return data;
+   }
+
    //
    // Lump_FilePart::sizeData
    //
@@ -191,6 +287,14 @@ namespace GDCC::AR::Wad
    {
       out.write(data, size);
    }
+
+   //
+   // Lump_FilePart::writeDataAt
+   //
+   void Lump_FilePart::writeDataAt(Core::FileOutput &out, std::size_t pos) const
+   {
+      out.write(pos, data, size);
+   }
 }
 
 // EOF
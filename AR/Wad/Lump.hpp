@@ -39,11 +39,20 @@ namespace GDCC::AR::Wad
 
       Lump &operator = (Lump const &) = delete;
 
+      // Returns the lump's data, if available without writing it. Files may
+      // be read into buf, which must be kept for the result to remain valid.
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &buf) const;
+
+      // Returns a hash of the lump's data, or 0 if getData does not.
+      std::size_t getHash() const;
+
       virtual std::size_t sizeData() const = 0;
       virtual std::size_t sizeHead() const;
 
       virtual void writeData(std::ostream &out) const = 0;
+      virtual void writeDataAt(Core::FileOutput &out, std::size_t pos) const;
       virtual void writeDirs(std::string &out) const;
+      void writeFile(char const *filename) const;
       virtual void writeHead(std::ostream &out, std::size_t offset) const;
       virtual void writeList(std::ostream &out, std::string &path) const;
 
@@ -52,6 +61,8 @@ namespace GDCC::AR::Wad
 
    private:
       using ListUtil = Core::ListUtil<Lump, &Lump::wadPrev, &Lump::wadNext>;
+
+      mutable std::size_t cacheHash = 0;
    };
 
    //
@@ -62,9 +73,12 @@ namespace GDCC::AR::Wad
    public:
       Lump_Data(Core::String name, std::unique_ptr<char[]> &&data, std::size_t size);
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &buf) const;
+
       virtual std::size_t sizeData() const;
 
       virtual void writeData(std::ostream &out) const;
+      virtual void writeDataAt(Core::FileOutput &out, std::size_t pos) const;
 
    private:
       std::unique_ptr<char[]> data;
@@ -92,9 +106,12 @@ namespace GDCC::AR::Wad
    public:
       Lump_File(Core::String name, std::unique_ptr<char[]> &&file);
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &buf) const;
+
       virtual std::size_t sizeData() const;
 
       virtual void writeData(std::ostream &out) const;
+      virtual void writeDataAt(Core::FileOutput &out, std::size_t pos) const;
 
    private:
       std::unique_ptr<char[]> file;
@@ -111,9 +128,12 @@ namespace GDCC::AR::Wad
          std::shared_ptr<Core::FileBlock> const &file);
       virtual ~Lump_FilePart();
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &buf) const;
+
       virtual std::size_t sizeData() const;
 
       virtual void writeData(std::ostream &out) const;
+      virtual void writeDataAt(Core::FileOutput &out, std::size_t pos) const;
 
    private:
       std::shared_ptr<Core::FileBlock> file;
@@ -12,10 +12,364 @@
 
 #include "AR/Wad/Wad.hpp"
 
+#include "AR/Wad/LumpInfo.hpp"
+
 #include "Core/BinaryIO.hpp"
 #include "Core/Dir.hpp"
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
 #include "Core/Path.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::AR::Wad
+{
+   //
+   // LumpJob
+   //
+   class LumpJob
+   {
+   public:
+      Lump const *lump;
+      std::size_t pos;
+      bool        write;
+   };
+
+   //
+   // LumpDir
+   //
+   class LumpDir
+   {
+   public:
+      Lump const *lump;
+      std::string path;
+   };
+
+   //
+   // LumpData
+   //
+   // Data already placed in the output, indexed by hash.
+   //
+   class LumpData
+   {
+   public:
+      using Map     = std::unordered_multimap<std::size_t,  LumpData>;
+      using NameMap = std::unordered_multimap<Core::String, LumpData>;
+
+      Lump const  *lump;
+      char const  *data;
+      std::size_t  size;
+      std::size_t  pos;
+      Core::String name;
+   };
+
+   //
+   // WadBlock
+   //
+   // A sub-wad's data, written to memory.
+   //
+   class WadBlock : public Core::FileBlock
+   {
+   public:
+      explicit WadBlock(std::string &&str) : buf{std::move(str)} {}
+
+   protected:
+      virtual char const *v_data() const {return buf.data();}
+
+      virtual std::size_t v_size() const {return buf.size();}
+
+   private:
+      std::string buf;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::AR::Wad
+{
+   //
+   // AddLumpJobs
+   //
+   // Adds a job for lump's data, or for each of its parts if it is a sub-wad
+   // embedded in the directory.
+   //
+   static void AddLumpJobs(std::vector<LumpJob> &jobs, Lump const &lump)
+   {
+      if(auto wad = dynamic_cast<Lump_Wad const *>(&lump); wad && wad->embed)
+      {
+         if(wad->head)
+            AddLumpJobs(jobs, *wad->head);
+
+         for(auto const &sub : wad->wad)
+            AddLumpJobs(jobs, sub);
+
+         if(wad->tail)
+            AddLumpJobs(jobs, *wad->tail);
+      }
+      else
+         jobs.push_back({&lump, 0, true});
+   }
+
+   //
+   // AddLumpDirs
+   //
+   // Adds a job to extract lump into path, creating directories for sub-wads.
+   // File names are made here, as strings cannot be created concurrently.
+   // A later lump with the same path replaces the earlier one's job, as it
+   // would have overwritten its file.
+   //
+   static void AddLumpDirs(std::vector<LumpDir> &jobs,
+      std::unordered_map<std::string, std::size_t> &paths, Lump const &lump,
+      std::string &path)
+   {
+      if(auto wad = dynamic_cast<Lump_Wad const *>(&lump))
+      {
+         Core::PathRestore pathRestore{path};
+
+         Core::PathAppend(path, wad->name);
+         Core::DirCreate(path.data());
+
+         for(auto const &sub : wad->wad)
+            AddLumpDirs(jobs, paths, sub, path);
+
+         if(wad->head) AddLumpDirs(jobs, paths, *wad->head, path);
+         if(wad->tail) AddLumpDirs(jobs, paths, *wad->tail, path);
+      }
+      else
+      {
+         std::string file = path;
+         Core::PathAppend(file, GetFileFromName(lump.name));
+
+         auto [itr, added] = paths.emplace(file, jobs.size());
+
+         if(added)
+            jobs.push_back({&lump, std::move(file)});
+         else
+            jobs[itr->second].lump = &lump;
+      }
+   }
+
+   //
+   // FindLumpData
+   //
+   // Looks for data identical to lump's, preferring data stored for a lump
+   // of the same name. If found, sets job to use it.
+   //
+   static bool FindLumpData(LumpData::Map const &map, LumpJob &job)
+   {
+      auto size = job.lump->sizeData();
+      auto hash = job.lump->getHash();
+
+      if(!size || !hash)
+         return false;
+
+      std::unique_ptr<Core::FileBlock> buf, bufOld;
+      char const     *data  = nullptr;
+      LumpData const *found = nullptr;
+
+      for(auto [itr, end] = map.equal_range(hash); itr != end; ++itr)
+      {
+         auto const &old = itr->second;
+
+         if(old.size != size || (found && old.name != job.lump->name))
+            continue;
+
+         if(!data && !(data = job.lump->getData(buf)))
+            return false;
+
+         auto dataOld = old.data ? old.data : old.lump->getData(bufOld);
+
+         if(dataOld && !std::memcmp(data, dataOld, size))
+         {
+            found = &old;
+
+            if(old.name == job.lump->name)
+               break;
+         }
+      }
+
+      if(!found)
+         return false;
+
+      job.pos   = found->pos;
+      job.write = false;
+      return true;
+   }
+
+   //
+   // FindLumpName
+   //
+   // Looks for lump's data stored for a lump of the same name, which avoids
+   // hashing the data for unchanged lumps. If found, sets job to use it.
+   //
+   static bool FindLumpName(LumpData::NameMap const &map, LumpJob &job)
+   {
+      auto size = job.lump->sizeData();
+
+      std::unique_ptr<Core::FileBlock> buf;
+      char const *data = nullptr;
+
+      for(auto [itr, end] = map.equal_range(job.lump->name); itr != end; ++itr)
+      {
+         auto const &old = itr->second;
+
+         if(old.size != size)
+            continue;
+
+         if(!data && !(data = job.lump->getData(buf)))
+            return false;
+
+         if(!std::memcmp(data, old.data, size))
+         {
+            job.pos   = old.pos;
+            job.write = false;
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   //
+   // GetLumpJobs
+   //
+   // Lays out the data for each directory entry in wad, following the
+   // directory. If deduplicating, entries with identical data share a copy.
+   //
+   static std::vector<LumpJob> GetLumpJobs(Wad const &wad)
+   {
+      std::vector<LumpJob> jobs;
+      for(auto const &lump : wad)
+         AddLumpJobs(jobs, lump);
+
+      LumpData::Map map;
+      std::size_t   pos = 16 + jobs.size() * 16;
+
+      for(auto &job : jobs)
+      {
+         if(wad.dedup && FindLumpData(map, job))
+            continue;
+
+         job.pos = pos;
+         pos += job.lump->sizeData();
+
+         if(wad.dedup)
+         {
+            if(auto hash = job.lump->getHash())
+               map.emplace(hash, LumpData{job.lump, nullptr, job.lump->sizeData(), job.pos, job.lump->name});
+         }
+      }
+
+      return jobs;
+   }
+
+   //
+   // RunJobs
+   //
+   // Calls fn for each index below n, using up to jobs threads. The first
+   // exception thrown stops further calls and is rethrown once all threads
+   // have finished. Since Core::String interning is not thread-safe, fn
+   // must not create strings, which Core::File's errors also avoid.
+   //
+   static void RunJobs(std::size_t n, unsigned jobs,
+      std::function<void(std::size_t)> const &fn)
+   {
+      if(jobs > n)
+         jobs = static_cast<unsigned>(n);
+
+      if(jobs <= 1)
+      {
+         for(std::size_t i = 0; i != n; ++i)
+            fn(i);
+
+         return;
+      }
+
+      std::atomic<std::size_t> next{0};
+      std::exception_ptr       err;
+      std::mutex               errLock;
+
+      auto run = [&]()
+      {
+         for(std::size_t i; (i = next++) < n;) try
+         {
+            fn(i);
+         }
+         catch(...)
+         {
+            std::lock_guard<std::mutex> lock{errLock};
+            if(!err) err = std::current_exception();
+            next = n;
+         }
+      };
+
+      std::vector<std::thread> threads;
+      while(threads.size() + 1 != jobs)
+         threads.emplace_back(run);
+
+      run();
+
+      for(auto &thread : threads)
+         thread.join();
+
+      if(err)
+         std::rethrow_exception(err);
+   }
+
+   //
+   // WriteHeader
+   //
+   static void WriteHeader(std::ostream &out, Wad const &wad,
+      std::vector<LumpJob> const &jobs, std::size_t offset)
+   {
+      // Write archive header.
+      out.write(wad.iwad ? "IWAD" : "PWAD", 4);
+      Core::WriteLE4(out, jobs.size());
+      Core::WriteLE4(out, offset);
+      out.write("GDCC", 4);
+   }
+
+   //
+   // WriteDirectory
+   //
+   static void WriteDirectory(std::ostream &out, std::vector<LumpJob> const &jobs)
+   {
+      for(auto const &job : jobs)
+         job.lump->writeHead(out, job.pos);
+   }
+
+   //
+   // WriteLumpJobs
+   //
+   static void WriteLumpJobs(Core::FileOutput &out, std::size_t pos,
+      std::vector<LumpJob> const &jobs, unsigned threads)
+   {
+      std::vector<LumpJob const *> writes;
+      for(auto const &job : jobs)
+         if(job.write) writes.push_back(&job);
+
+      RunJobs(writes.size(), threads, [&](std::size_t i)
+         {writes[i]->lump->writeDataAt(out, pos + writes[i]->pos);});
+   }
+}
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -27,7 +381,8 @@ namespace GDCC::AR::Wad
    // Wad constructor
    //
    Wad::Wad() :
-      iwad{false}
+      dedup{false},
+      iwad {false}
    {
    }
 
@@ -71,6 +426,16 @@ namespace GDCC::AR::Wad
    //
    std::size_t Wad::sizeData() const
    {
+      if(dedup)
+      {
+         auto jobs = GetLumpJobs(*this);
+
+         std::size_t n = 16 + jobs.size() * 16;
+         for(auto const &job : jobs)
+            if(job.write) n += job.lump->sizeData();
+         return n;
+      }
+
       std::size_t n = 16;
       for(auto const &lump : *this)
          n += lump.sizeHead() * 16 + lump.sizeData();
@@ -82,40 +447,53 @@ namespace GDCC::AR::Wad
    //
    void Wad::writeData(std::ostream &out) const
    {
-      // Count number of lumps.
-      std::size_t numLumps = 0;
-      for(auto const &lump : *this)
-         numLumps += lump.sizeHead();
+      auto jobs = GetLumpJobs(*this);
 
-      // Write archive header.
-      std::size_t offset = 16;
-      out.write(iwad ? "IWAD" : "PWAD", 4);
-      Core::WriteLE4(out, numLumps);
-      Core::WriteLE4(out, offset);
-      out.write("GDCC", 4);
+      WriteHeader(out, *this, jobs, 16);
+      WriteDirectory(out, jobs);
 
-      // Write lump headers.
-      offset += numLumps * 16;
-      for(auto const &lump : *this)
-      {
-         lump.writeHead(out, offset);
-         offset += lump.sizeData();
-      }
+      // Write lump data. Written data is in directory order.
+      for(auto const &job : jobs)
+         if(job.write) job.lump->writeData(out);
+   }
 
-      // Write lump data.
-      for(auto const &lump : *this)
-         lump.writeData(out);
+   //
+   // Wad::writeDataAt
+   //
+   // The directory is written first, after which each lump's data is at a
+   // known offset and can be written independently.
+   //
+   void Wad::writeDataAt(Core::FileOutput &out, std::size_t pos, unsigned jobs) const
+   {
+      auto lumps = GetLumpJobs(*this);
+
+      std::ostringstream dir;
+      WriteHeader(dir, *this, lumps, 16);
+      WriteDirectory(dir, lumps);
+
+      auto dirStr = dir.str();
+      out.write(pos, dirStr.data(), dirStr.size());
+
+      WriteLumpJobs(out, pos, lumps, jobs);
    }
 
    //
    // Wad::writeDirs
    //
-   void Wad::writeDirs(std::string &path) const
+   // Directories are all created first, after which each lump's file can be
+   // written independently.
+   //
+   void Wad::writeDirs(std::string &path, unsigned jobs) const
    {
       Core::DirCreate(path.data());
 
+      std::vector<LumpDir>                         lumps;
+      std::unordered_map<std::string, std::size_t> paths;
       for(auto const &lump : *this)
-         lump.writeDirs(path);
+         AddLumpDirs(lumps, paths, lump, path);
+
+      RunJobs(lumps.size(), jobs, [&](std::size_t i)
+         {lumps[i].lump->writeFile(lumps[i].path.data());});
    }
 
    //
@@ -136,6 +514,133 @@ namespace GDCC::AR::Wad
          lump.writeList(out, path);
    }
 
+   //
+   // Wad::writeUpdate
+   //
+   // Lumps whose data is already in the file are pointed at it, and the rest
+   // are appended to it. The new directory is then appended, and the header
+   // is rewritten last, so that the file remains valid if interrupted. Data
+   // no longer in the directory is left in place until the file is rewritten.
+   //
+   bool Wad::writeUpdate(char const *filename, unsigned jobs) const
+   {
+      std::unique_ptr<Core::FileBlock> file;
+      try
+      {
+         file = Core::FileOpenBlock(filename);
+      }
+      catch(Core::Exception const &)
+      {
+         return false;
+      }
+
+      auto out = Core::FileOpenUpdate(filename);
+      if(!out)
+         return false;
+
+      // Read existing directory.
+      char const *data = file->data();
+      std::size_t size = file->size();
+
+      if(size < 16 || (std::memcmp(data, "PWAD", 4) && std::memcmp(data, "IWAD", 4)))
+         return false;
+
+      std::size_t numOld = Core::ReadLE4(data + 4);
+      std::size_t dirOld = Core::ReadLE4(data + 8);
+
+      if(dirOld > size || numOld > (size - dirOld) / 16)
+         return false;
+
+      LumpData::NameMap names;
+      for(char const *itr = data + dirOld, *end = itr + numOld * 16; itr != end; itr += 16)
+      {
+         std::size_t lumpPos  = Core::ReadLE4(itr + 0);
+         std::size_t lumpSize = Core::ReadLE4(itr + 4);
+
+         if(lumpSize && lumpPos <= size && lumpSize <= size - lumpPos)
+         {
+            Core::String name{itr + 8,
+               static_cast<std::size_t>(std::find(itr + 8, itr + 16, '\0') - (itr + 8))};
+
+            names.emplace(name, LumpData{nullptr, data + lumpPos, lumpSize, lumpPos, name});
+         }
+      }
+
+      // Existing data by hash, only built if a lump is not found by name.
+      LumpData::Map map;
+      bool          mapOld = false;
+
+      // Lay out lumps, appending any new data. Empty lumps are placed after
+      // the previous lump, as when writing the whole archive.
+      std::vector<LumpJob> lumps;
+      for(auto const &lump : *this)
+         AddLumpJobs(lumps, lump);
+
+      std::size_t pos  = size;
+      std::size_t next = 16 + lumps.size() * 16;
+      for(auto &job : lumps)
+      {
+         if(!job.lump->sizeData())
+         {
+            job.pos   = next;
+            job.write = false;
+            continue;
+         }
+
+         bool found = FindLumpName(names, job);
+
+         if(!found)
+         {
+            if(!mapOld)
+            {
+               for(auto const &old : names)
+                  map.emplace(Core::StrHash(old.second.data, old.second.size), old.second);
+
+               mapOld = true;
+            }
+
+            found = FindLumpData(map, job);
+         }
+
+         if(found)
+         {
+            next = job.pos + job.lump->sizeData();
+            continue;
+         }
+
+         job.pos = pos;
+         pos += job.lump->sizeData();
+         next = pos;
+
+         if(dedup)
+         {
+            if(auto hash = job.lump->getHash())
+               map.emplace(hash, LumpData{job.lump, nullptr, job.lump->sizeData(), job.pos, job.lump->name});
+         }
+      }
+
+      std::ostringstream dir;
+      WriteDirectory(dir, lumps);
+      auto dirStr = dir.str();
+
+      // Nothing changed, so leave the file as it is.
+      if(pos == size && numOld == lumps.size() &&
+         !std::memcmp(data, iwad ? "IWAD" : "PWAD", 4) &&
+         !dirStr.compare(0, dirStr.size(), data + dirOld, numOld * 16))
+         return true;
+
+      WriteLumpJobs(*out, 0, lumps, jobs);
+
+      out->write(pos, dirStr.data(), dirStr.size());
+
+      std::ostringstream hdr;
+      WriteHeader(hdr, *this, lumps, pos);
+      auto hdrStr = hdr.str();
+      out->write(0, hdrStr.data(), hdrStr.size());
+
+      return true;
+   }
+
    //
    // Lump_Wad constructor
    //
@@ -145,6 +650,22 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_Wad::getData
+   //
+   char const *Lump_Wad::getData(std::unique_ptr<Core::FileBlock> &buf) const
+   {
+      // An embedded sub-wad's parts are placed separately.
+      if(embed)
+         return nullptr;
+
+      std::ostringstream out;
+      wad.writeData(out);
+      buf = std::make_unique<WadBlock>(out.str());
+
+      return buf->data();
+   }
+
    //
    // Lump_Wad::sizeData
    //
@@ -200,6 +721,26 @@ namespace GDCC::AR::Wad
          wad.writeData(out);
    }
 
+   //
+   // Lump_Wad::writeDataAt
+   //
+   void Lump_Wad::writeDataAt(Core::FileOutput &out, std::size_t pos) const
+   {
+      if(embed)
+      {
+         if(head)
+            head->writeDataAt(out, pos), pos += head->sizeData();
+
+         for(Lump const &lump : wad)
+            lump.writeDataAt(out, pos), pos += lump.sizeData();
+
+         if(tail)
+            tail->writeDataAt(out, pos);
+      }
+      else
+         wad.writeDataAt(out, pos);
+   }
+
    //
    // Lump_Wad::writeDirs
    //
@@ -59,10 +59,16 @@ namespace GDCC::AR::Wad
       std::size_t sizeData() const;
 
       void writeData(std::ostream &out) const;
-      void writeDirs(std::string &path) const;
+      void writeDataAt(Core::FileOutput &out, std::size_t pos, unsigned jobs = 1) const;
+      void writeDirs(std::string &path, unsigned jobs = 1) const;
       void writeList(std::ostream &out) const;
       void writeList(std::ostream &out, std::string &path) const;
 
+      // Updates an existing archive in place, reusing the data it already
+      // has. Returns false if the file cannot be updated.
+      bool writeUpdate(char const *filename, unsigned jobs = 1) const;
+
+      bool dedup;
       bool iwad;
 
    private:
@@ -81,10 +87,13 @@ namespace GDCC::AR::Wad
 
       void addLump(LumpInfo const &info, Core::Range<Core::String const *> path);
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &buf) const;
+
       virtual std::size_t sizeData() const;
       virtual std::size_t sizeHead() const;
 
       virtual void writeData(std::ostream &out) const;
+      virtual void writeDataAt(Core::FileOutput &out, std::size_t pos) const;
       virtual void writeDirs(std::string &path) const;
       virtual void writeHead(std::ostream &out, std::size_t offset) const;
       virtual void writeList(std::ostream &out, std::string &path) const;
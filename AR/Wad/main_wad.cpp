@@ -13,19 +13,54 @@
 #include "AR/Wad/LumpInfo.hpp"
 #include "AR/Wad/Wad.hpp"
 
+#include "Core/Exception.hpp"
 #include "Core/File.hpp"
 #include "Core/Option.hpp"
 
 #include "Option/Bool.hpp"
+#include "Option/Int.hpp"
 
+#include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 
 //----------------------------------------------------------------------------|
 // Options                                                                    |
 //
 
+//
+// --compact
+//
+static GDCC::Option::Bool Compact
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("compact")
+      .setGroup("output")
+      .setDescS("With --update, rewrites the whole archive.")
+      .setDescL("With --update, rewrites the whole archive, discarding data "
+         "no longer in its directory. The archive is written to a temporary "
+         "file and then renamed, so sources may include the archive itself."),
+
+   false
+};
+
+//
+// --dedup
+//
+static GDCC::Option::Bool Dedup
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("dedup")
+      .setGroup("output")
+      .setDescS("Stores identical lumps' data once.")
+      .setDescL("Stores identical lumps' data once, with each of their "
+         "directory entries pointing at the same copy. Default off."),
+
+   false
+};
+
 //
 // --extract
 //
@@ -52,6 +87,40 @@ static GDCC::Option::Bool IWad
    false
 };
 
+//
+// -j, --jobs
+//
+static GDCC::Option::Int<unsigned> Jobs
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("jobs").setName('j')
+      .setGroup("output")
+      .setDescS("Sets the number of threads used to write lumps.")
+      .setDescL("Sets the number of threads used to write lumps, whether to "
+         "an archive or when extracting. Default is 0, which uses one per "
+         "processor."),
+
+   0
+};
+
+//
+// --update
+//
+static GDCC::Option::Bool Update
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("update")
+      .setGroup("output")
+      .setDescS("Updates an existing archive in place.")
+      .setDescL("Updates an existing archive in place. Lumps whose data is "
+         "already in the archive are kept where they are, and only new or "
+         "changed data is written, followed by a new directory. Data that "
+         "is no longer used remains until --compact is used. If the output "
+         "is not an existing archive, it is written in full."),
+
+   false
+};
+
 //
 // --list
 //
@@ -70,13 +139,41 @@ static GDCC::Option::CStr OptionList
 
 static void ProcessFile(char const *data, GDCC::AR::Wad::Wad &wad);
 
+//
+// GetJobs
+//
+static unsigned GetJobs()
+{
+   unsigned jobs = Jobs ? Jobs : std::thread::hardware_concurrency();
+   return jobs ? jobs : 1;
+}
+
+//
+// WriteWad
+//
+static void WriteWad(GDCC::AR::Wad::Wad const &wad, char const *outFile)
+{
+   if(auto file = GDCC::Core::FileOpenOutput(outFile))
+   {
+      wad.writeDataAt(*file, 0, GetJobs());
+   }
+   else
+   {
+      auto buf = GDCC::Core::FileOpenStream(outFile,
+         std::ios_base::out | std::ios_base::binary);
+      std::ostream out{buf.get()};
+      wad.writeData(out);
+   }
+}
+
 //
 // MakeWad
 //
 static void MakeWad()
 {
    GDCC::AR::Wad::Wad wad;
-   wad.iwad = IWad;
+   wad.dedup = Dedup;
+   wad.iwad  = IWad;
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
@@ -96,15 +193,21 @@ static void MakeWad()
       if(Extract)
       {
          std::string path{outFile};
-         wad.writeDirs(path);
+         wad.writeDirs(path, GetJobs());
       }
-      else
+      else if(Update && Compact)
       {
-         auto buf = GDCC::Core::FileOpenStream(outFile,
-            std::ios_base::out | std::ios_base::binary);
-         std::ostream out{buf.get()};
-         wad.writeData(out);
+         std::string tmpFile = std::string{outFile} + ".tmp";
+         WriteWad(wad, tmpFile.data());
+
+         if(std::rename(tmpFile.data(), outFile))
+         {
+            std::remove(tmpFile.data());
+            GDCC::Core::ErrorFile(outFile, "writing");
+         }
       }
+      else if(!Update || !wad.writeUpdate(outFile, GetJobs()))
+         WriteWad(wad, outFile);
    }
 }
 
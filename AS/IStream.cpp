@@ -12,12 +12,11 @@
 
 #include "AS/IStream.hpp"
 
+#include "Core/CharClass.hpp"
 #include "Core/Exception.hpp"
 #include "Core/Parse.hpp"
 #include "Core/Token.hpp"
 
-#include <cctype>
-
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -32,7 +31,7 @@ namespace GDCC::AS
    {
       // Skip leading whitespace.
       int c = in.get();
-      while(std::isspace(c)) c = in.get();
+      while(Core::IsCharSpace(c)) c = in.get();
 
       out.pos = in.getOrigin();
 
@@ -122,7 +121,7 @@ namespace GDCC::AS
       }
 
       // Number token.
-      if(std::isdigit(c))
+      if(Core::IsCharDigit(c))
       {
          in.putback(c);
 
@@ -134,13 +133,10 @@ namespace GDCC::AS
       }
 
       // Identifier token.
-      if(std::isalpha(c) || c == '_')
+      if(Core::IsCharAlpha(c) || c == '_')
       {
-         std::string str;
-
-         do str += static_cast<char>(c);
-         while((c = in.get()) != EOF && (std::isalnum(c) || c == '_'));
-         if(c != EOF) in.unget();
+         std::string str{static_cast<char>(c)};
+         Core::ReadCharClass(in, str, Core::CharWord);
 
          out.str = {str.data(), str.size()};
          out.tok = Core::TOK_Identi;
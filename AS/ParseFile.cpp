@@ -16,6 +16,7 @@
 #include "AS/TStream.hpp"
 
 #include "Core/File.hpp"
+#include "Core/Stats.hpp"
 #include "Core/Token.hpp"
 
 
@@ -36,6 +37,8 @@ namespace GDCC::AS
       MacroMap  macros{};
       ParserCtx ctx   {in, macros, prog};
 
+      Core::StatPhase phase{"parse"};
+
       while(!ctx.in.peek(Core::TOK_EOF))
          AS::ParseDeclaration(ctx);
    }
@@ -16,6 +16,7 @@
 
 #include "IR/Program.hpp"
 
+#include "LD/Cache.hpp"
 #include "LD/Linker.hpp"
 
 #include <iostream>
@@ -34,10 +35,10 @@ static void MakeAsm()
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      GDCC::AS::ParseFile(arg, prog);
+      GDCC::LD::CacheParse(arg, prog, GDCC::AS::ParseFile);
 
    for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
-      GDCC::AS::ParseFile(arg, prog);
+      GDCC::LD::CacheParse(arg, prog, GDCC::AS::ParseFile);
 
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
@@ -13,6 +13,7 @@
 #ifndef GDCC__BC__AddFunc_H__
 #define GDCC__BC__AddFunc_H__
 
+#include "../BC/HelperLib.hpp"
 #include "../BC/Types.hpp"
 
 #include "../Core/Array.hpp"
@@ -32,6 +33,7 @@
 // GDCC_BC_AddFuncEnd
 //
 #define GDCC_BC_AddFuncEnd() \
+   HelperSave(*newFunc); \
    throw ResetFunc()
 
 //
@@ -25,17 +25,6 @@
 
 namespace GDCC::BC::DGE
 {
-   //
-   // Info::backGlyphObj
-   //
-   void Info::backGlyphObj(Core::String glyph, Core::FastU val)
-   {
-      auto &data = prog->getGlyphData(glyph);
-
-      data.value = IR::ExpCreate_Value(IR::Value_Point(val,
-         data.type.tPoint.reprB, data.type.tPoint.reprN, data.type.tPoint), {nullptr, 0});
-   }
-
    //
    // Info::getFixedInfo
    //
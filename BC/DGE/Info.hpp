@@ -34,8 +34,6 @@ namespace GDCC::BC::DGE
    class Info : public InfoBase
    {
    protected:
-      void backGlyphObj(Core::String glyph, Core::FastU val);
-
       virtual void chkStmnt();
 
       void chkStmnt_AddX();
@@ -239,6 +237,7 @@ namespace GDCC::BC::DGE
       void putStmnt_Jcnd_Nil(char const *code = "Jcnd_Nil");
       void putStmnt_Jcnd_Tab();
       void putStmnt_Jcnd_Tru();
+      void putStmnt_Jdyn() {putStmnt_Jump();}
       void putStmnt_Jfar_Pro();
       void putStmnt_Jfar_Set();
       void putStmnt_Jfar_Sta();
@@ -339,6 +338,7 @@ namespace GDCC::BC::DGE
       void trStmnt_Jcnd_Nil();
       void trStmnt_Jcnd_Tab() {}
       void trStmnt_Jcnd_Tru() {trStmnt_Jcnd_Nil();}
+      void trStmnt_Jdyn() {trStmnt_Jump();}
       void trStmnt_Jfar_Pro() {}
       void trStmnt_Jfar_Set() {}
       void trStmnt_Jfar_Sta() {}
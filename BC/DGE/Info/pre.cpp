@@ -28,6 +28,9 @@ namespace GDCC::BC::DGE
    //
    void Info::preStmnt()
    {
+      if(preStmntConst())
+         throw ResetStmnt();
+
       switch(stmnt->code.base)
       {
       case IR::CodeBase::Add:   preStmnt_Add(); break;
@@ -58,6 +58,7 @@ namespace GDCC::BC::DGE
       case IR::CodeBase::Jcnd_Nil: putStmnt_Jcnd_Nil(); break;
       case IR::CodeBase::Jcnd_Tab: putStmnt_Jcnd_Tab(); break;
       case IR::CodeBase::Jcnd_Tru: putStmnt_Jcnd_Tru(); break;
+      case IR::CodeBase::Jdyn:     putStmnt_Jdyn(); break;
       case IR::CodeBase::Jfar_Pro: putStmnt_Jfar_Pro(); break;
       case IR::CodeBase::Jfar_Set: putStmnt_Jfar_Set(); break;
       case IR::CodeBase::Jfar_Sta: putStmnt_Jfar_Sta(); break;
@@ -53,6 +53,7 @@ namespace GDCC::BC::DGE
       case IR::CodeBase::Jcnd_Nil: trStmnt_Jcnd_Nil(); break;
       case IR::CodeBase::Jcnd_Tab: trStmnt_Jcnd_Tab(); break;
       case IR::CodeBase::Jcnd_Tru: trStmnt_Jcnd_Tru(); break;
+      case IR::CodeBase::Jdyn:     trStmnt_Jdyn(); break;
       case IR::CodeBase::Jfar_Pro: trStmnt_Jfar_Pro(); break;
       case IR::CodeBase::Jfar_Set: trStmnt_Jfar_Set(); break;
       case IR::CodeBase::Jfar_Sta: trStmnt_Jfar_Sta(); break;
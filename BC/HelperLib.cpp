@@ -0,0 +1,391 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Prebuilt helper function library.
+//
+// There is one library file per target, holding:
+//    magic "GDCC::HELP\0\0"
+//    version (LE4 length, bytes)
+//    helper count (LE4)
+//    helpers (LE4 name length, name bytes, LE4 offset)
+//    IR archive (to end of file)
+//
+// The helper names encode their codes and operand sizes. Each offset is to
+// the helper's definition within the IR archive, as generated before any
+// passes, so the archive's string table is only read once. The version is
+// made of HelperFormat, the tool version, and the executable's digest, so a
+// library from any other build is ignored and replaced.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/HelperLib.hpp"
+
+#include "Core/BinaryIO.hpp"
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+#include "Core/Path.hpp"
+#include "Core/StringBuf.hpp"
+
+#include "IR/Function.hpp"
+#include "IR/IArchive.hpp"
+#include "IR/OArchive.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/CStr.hpp"
+
+#include "Target/Info.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-helper-dir
+   //
+   static Option::CStr HelperDir
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-helper-dir")
+         .setGroup("codegen")
+         .setDescS("Sets a directory of prebuilt helper functions.")
+         .setDescL("Sets a directory of prebuilt helper functions, with one "
+            "library per target. Helpers needed for arithmetic and "
+            "conversions are read from the library instead of being "
+            "generated, and helpers it lacks are generated and added to it "
+            "when the program exits. Building the libraries with "
+            "gdcc-makelib and this option fills it with the common helpers.")
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::BC
+{
+   static char const HelperMagic[12] = "GDCC::HELP";
+
+   // Bump when the library layout or any addFunc generator changes.
+   static int const HelperFormat = 1;
+
+   // Library as read.
+   static std::unique_ptr<Core::FileBlock> HelperFile;
+   static std::unique_ptr<Core::StringBuf> HelperBuf;
+   static std::unique_ptr<std::istream>    HelperIn;
+   static std::unique_ptr<IR::IArchive>    HelperArc;
+
+   static std::unordered_map<Core::String, std::size_t> HelperIdx;
+
+   // Library to write, if helpers were generated.
+   static std::unique_ptr<IR::Program> HelperNew;
+
+   static bool HelperRead = false;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GetHelperPath
+   //
+   static std::string GetHelperPath()
+   {
+      std::string path{HelperDir.data(), HelperDir.size()};
+      std::string name = "helper-" +
+         std::to_string(static_cast<int>(Target::EngineCur)) + '-' +
+         std::to_string(static_cast<int>(Target::FormatCur)) + ".lib";
+
+      return Core::PathAppend(path, name.data());
+   }
+
+   //
+   // GetHelperVersion
+   //
+   static std::string GetHelperVersion()
+   {
+      auto version = Core::GetOptions().list.version;
+
+      return std::to_string(HelperFormat) + ' ' + (version ? version : "") +
+         ' ' + Core::GetOptionBuild();
+   }
+
+   //
+   // ReadLE4
+   //
+   static bool ReadLE4(char const *&itr, char const *end, std::uint_fast32_t &out)
+   {
+      if(end - itr < 4)
+         return false;
+
+      out = Core::ReadLE4(itr);
+      itr += 4;
+      return true;
+   }
+
+   //
+   // ReadStr
+   //
+   static bool ReadStr(char const *&itr, char const *end, std::string &out)
+   {
+      std::uint_fast32_t len;
+      if(!ReadLE4(itr, end, len) || static_cast<std::size_t>(end - itr) < len)
+         return false;
+
+      out.assign(itr, len);
+      itr += len;
+      return true;
+   }
+
+   //
+   // WriteStr
+   //
+   static void WriteStr(std::ostream &out, char const *str, std::size_t len)
+   {
+      Core::WriteLE4(out, len);
+      out.write(str, len);
+   }
+
+   //
+   // HelperGet
+   //
+   // Reads a helper from the library into prog.
+   //
+   static void HelperGet(IR::Program &prog, Core::String name, std::size_t offset)
+   {
+      HelperIn->clear();
+      HelperIn->seekg(offset);
+      HelperArc->prog = &prog;
+
+      IR::Function newFunc{name};
+      *HelperArc >> newFunc;
+
+      prog.mergeFunction(prog.getFunction(name), std::move(newFunc));
+   }
+
+   //
+   // HelperFlush
+   //
+   // Failure to write is not an error, as the library only saves work.
+   //
+   static void HelperFlush()
+   {
+      // Keep the helpers already in the library.
+      try
+      {
+         for(auto const &helper : HelperIdx)
+         {
+            if(!HelperNew->findFunction(helper.first))
+               HelperGet(*HelperNew, helper.first, helper.second);
+         }
+      }
+      catch(Core::Exception const &)
+      {
+         return;
+      }
+
+      std::ostringstream ir;
+      std::vector<std::pair<Core::String, std::size_t>> idx;
+      {
+         IR::OArchive arc{ir};
+         arc.putHead();
+
+         for(auto const &fn : HelperNew->rangeFunction())
+         {
+            idx.emplace_back(fn.glyph, static_cast<std::size_t>(ir.tellp()));
+            arc << fn;
+         }
+
+         arc.putTail();
+      }
+
+      std::ostringstream out;
+
+      out.write(HelperMagic, 12);
+      auto version = GetHelperVersion();
+      WriteStr(out, version.data(), version.size());
+
+      Core::WriteLE4(out, idx.size());
+      for(auto const &helper : idx)
+      {
+         WriteStr(out, helper.first.data(), helper.first.size());
+         Core::WriteLE4(out, helper.second);
+      }
+
+      auto irStr = ir.str();
+      out.write(irStr.data(), irStr.size());
+
+      // Write to a unique temporary, then rename into place.
+      std::string path = GetHelperPath();
+      std::string tmp  = path + '.' + std::to_string(std::random_device{}()) + ".tmp";
+
+      {
+         std::filebuf fbuf;
+         if(!fbuf.open(tmp.data(), std::ios_base::out | std::ios_base::binary))
+            return;
+
+         auto data = out.str();
+         if(fbuf.sputn(data.data(), data.size()) !=
+            static_cast<std::streamsize>(data.size()) || !fbuf.close())
+         {
+            std::remove(tmp.data());
+            return;
+         }
+      }
+
+      if(std::rename(tmp.data(), path.data()))
+         std::remove(tmp.data());
+   }
+
+   //
+   // HelperReadLib
+   //
+   // Reads the library's index on first use. A missing or unreadable
+   // library is treated as empty.
+   //
+   static void HelperReadLib()
+   {
+      if(HelperRead)
+         return;
+
+      HelperRead = true;
+
+      try
+      {
+         HelperFile = Core::FileOpenBlock(GetHelperPath().data());
+      }
+      catch(Core::Exception const &)
+      {
+         return;
+      }
+
+      char const *itr = HelperFile->begin(), *end = HelperFile->end();
+
+      if(end - itr < 12 || std::memcmp(itr, HelperMagic, 12))
+         return;
+      itr += 12;
+
+      std::string str;
+      if(!ReadStr(itr, end, str) || str != GetHelperVersion())
+         return;
+
+      std::uint_fast32_t count;
+      if(!ReadLE4(itr, end, count))
+         return;
+
+      std::unordered_map<Core::String, std::size_t> idx;
+      while(count--)
+      {
+         std::uint_fast32_t offset;
+         if(!ReadStr(itr, end, str) || !ReadLE4(itr, end, offset))
+            return;
+
+         idx.emplace(Core::String{str.data(), str.size()}, offset);
+      }
+
+      try
+      {
+         HelperBuf.reset(new Core::StringBuf{itr, static_cast<std::size_t>(end - itr)});
+         HelperIn .reset(new std::istream{HelperBuf.get()});
+         HelperArc.reset(new IR::IArchive{*HelperIn});
+      }
+      catch(Core::Exception const &)
+      {
+         return;
+      }
+
+      HelperIdx = std::move(idx);
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // HelperLoad
+   //
+   bool HelperLoad(IR::Program &prog, Core::String name)
+   {
+      // Without the executable's digest, libraries from other builds cannot
+      // be told apart.
+      if(!HelperDir.data() || Core::GetOptionBuild().empty())
+         return false;
+
+      HelperReadLib();
+
+      auto itr = HelperIdx.find(name);
+      if(itr == HelperIdx.end())
+         return false;
+
+      HelperGet(prog, name, itr->second);
+
+      return true;
+   }
+
+   //
+   // HelperSave
+   //
+   void HelperSave(IR::Function const &fn)
+   {
+      if(!HelperDir.data() || Core::GetOptionBuild().empty())
+         return;
+
+      HelperReadLib();
+
+      if(!HelperNew)
+      {
+         HelperNew.reset(new IR::Program);
+         std::atexit(HelperFlush);
+      }
+
+      // Copy the definition as it is now, before any passes.
+      std::ostringstream out;
+      {
+         IR::OArchive arc{out};
+         arc.putHead();
+         arc << fn;
+         arc.putTail();
+      }
+
+      auto            str = out.str();
+      Core::StringBuf sbuf{str.data(), str.size()};
+      std::istream    in{&sbuf};
+      IR::IArchive    arc{in};
+
+      arc.prog = HelperNew.get();
+
+      IR::Function newFunc{fn.glyph};
+      arc >> newFunc;
+
+      HelperNew->mergeFunction(HelperNew->getFunction(fn.glyph), std::move(newFunc));
+   }
+}
+
+// EOF
+
@@ -0,0 +1,33 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Prebuilt helper function library.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__BC__HelperLib_H__
+#define GDCC__BC__HelperLib_H__
+
+#include "../BC/Types.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   // Defines the named helper in prog from the helper library, if present.
+   bool HelperLoad(IR::Program &prog, Core::String name);
+
+   // Adds a newly generated helper to the helper library.
+   void HelperSave(IR::Function const &fn);
+}
+
+#endif//GDCC__BC__HelperLib_H__
+
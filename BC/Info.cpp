@@ -12,7 +12,10 @@
 
 #include "BC/Info.hpp"
 
+#include "Core/Stats.hpp"
+
 #include "IR/Exception.hpp"
+#include "IR/Exp/Glyph.hpp"
 #include "IR/Program.hpp"
 
 
@@ -39,6 +42,10 @@
 //
 // DefaultFunc_Base
 //
+// Functions added during the pass are appended to funcPend by addFunc and
+// processed after the existing ones. Function references remain valid when
+// the table grows, so nothing is processed twice.
+//
 #define DefaultFunc_Base(set) \
    void Info::set() \
    { \
@@ -52,12 +59,18 @@
       set##Space(prog->getSpaceModReg()); \
       set##Space(prog->getSpaceSta()); \
       \
-      for(;;) try \
+      funcPend.clear(); \
+      for(auto &itr : prog->rangeFunction()) funcPend.push_back(&itr); \
+      for(std::size_t i = 0; i != funcPend.size(); ++i) \
       { \
-         for(auto &itr : prog->rangeFunction()) set##Func(itr); \
-         break; \
+         for(;;) try \
+         { \
+            set##Func(*funcPend[i]); \
+            break; \
+         } \
+         catch(ResetFunc const &) {} \
       } \
-      catch(ResetFunc const &) {} \
+      funcPend.clear(); \
       \
       for(auto &itr : prog->rangeDJump())  set##DJump(itr); \
       for(auto &itr : prog->rangeObject()) set##Obj(itr); \
@@ -67,6 +80,9 @@
 //
 // DefaultFunc_Block
 //
+// A statement that throws ResetFunc or ResetStmnt is processed again, the
+// former after having added a function it needs.
+//
 #define DefaultFunc_Block(set) \
    void Info::set##Block() \
    { \
@@ -81,6 +97,7 @@
                set##Stmnt(); \
                stmnt = stmnt->next; \
             } \
+            catch(ResetFunc const &) {} \
             catch(ResetStmnt const &) {} \
          } \
          stmnt = nullptr; \
@@ -117,6 +134,18 @@
       TryPointer(fun, ptr); \
    }
 
+//
+// DeferFuncPhase
+//
+// As DeferFunc for a whole program, timed as a phase.
+//
+#define DeferFuncPhase(fun) \
+   void Info::fun(IR::Program &prog##_) \
+   { \
+      Core::StatPhase phase{"bc-" #fun}; \
+      TryPointer(fun, prog); \
+   }
+
 //
 // DeferFuncSet
 //
@@ -144,19 +173,22 @@ namespace GDCC::BC
 
    DefaultFuncSet(chk)
    DefaultFuncSet(gen)
-   DefaultFuncSet(opt)
+   DefaultFunc_Block(opt)
    DefaultFuncSet(pre)
    DefaultFuncSet(put)
    DefaultFuncSet(tr)
 
-   DeferFunc(Program, chk, prog)
-   DeferFunc(Program, gen, prog)
-   DeferFunc(Program, opt, prog)
-   DeferFunc(Program, pre, prog)
-   DeferFunc(Program, tr,  prog)
+   DeferFuncPhase(chk)
+   DeferFuncPhase(inl)
+   DeferFuncPhase(opt)
+   DeferFuncPhase(pre)
+   DeferFuncPhase(prof)
+   DeferFuncPhase(tr)
 
    DeferFuncSet(chk)
    DeferFuncSet(gen)
+
+   DeferFunc(Function, inlFunc, func)
    DeferFuncSet(opt)
    DeferFuncSet(pre)
    DeferFuncSet(put)
@@ -164,11 +196,25 @@ namespace GDCC::BC
 
    DeferFunc(Program, putExtra, prog)
 
+   //
+   // Info::gen
+   //
+   void Info::gen(IR::Program &prog_)
+   {
+      Core::StatPhase phase{"bc-gen"};
+
+      // libGDCC references the profile glyphs even if no prof step ran.
+      TryPointer(profBack, prog);
+      TryPointer(gen, prog);
+   }
+
    //
    // Info::put
    //
    void Info::put(IR::Program &prog_, std::ostream &out_)
    {
+      Core::StatPhase phase{"bc-put"};
+
       try
       {
          out  = &out_;
@@ -188,6 +234,17 @@ namespace GDCC::BC
       }
    }
 
+   //
+   // Info::backGlyphObj
+   //
+   void Info::backGlyphObj(Core::String glyph, Core::FastU val)
+   {
+      auto &data = prog->getGlyphData(glyph);
+
+      data.value = IR::ExpCreate_Value(IR::Value_Point(val,
+         data.type.tPoint.reprB, data.type.tPoint.reprN, data.type.tPoint), {nullptr, 0});
+   }
+
    //
    // Info::errorCode
    //
@@ -321,6 +378,38 @@ namespace GDCC::BC
       return fi;
    }
 
+   //
+   // Info::getLocRegIdx
+   //
+   // Gets the byte index of a local register argument, if it is known.
+   // Local register object glyphs are not backed until gen, but their
+   // indexes are fixed, so they are resolved from the object.
+   //
+   bool Info::getLocRegIdx(IR::Arg_LocReg const &arg, Core::FastU &idx)
+   {
+      if(arg.idx->a != IR::ArgBase::Lit)
+         return false;
+
+      auto const &lit = arg.idx->aLit;
+
+      if(lit.value->isValue())
+      {
+         idx = getWord(lit) + arg.off;
+         return true;
+      }
+
+      auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*lit.value);
+      if(!exp || lit.off)
+         return false;
+
+      auto regObj = prog->findObject(exp->glyph);
+      if(!regObj || regObj->space.base != IR::AddrBase::LocReg || regObj->alloc)
+         return false;
+
+      idx = regObj->value + arg.off;
+      return true;
+   }
+
    //
    // Info::getStmntSize
    //
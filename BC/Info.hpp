@@ -19,6 +19,7 @@
 #include "../Core/Number.hpp"
 
 #include <ostream>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -169,10 +170,14 @@ namespace GDCC::BC
 
       void gen(IR::Program &prog);
 
+      void inl(IR::Program &prog);
+
       void opt(IR::Program &prog);
 
       void pre(IR::Program &prog);
 
+      void prof(IR::Program &prog);
+
       void put(IR::Program &prog, std::ostream &out);
 
       void putExtra(IR::Program &prog);
@@ -196,6 +201,8 @@ namespace GDCC::BC
       using WordArray = Core::Array<WordValue>;
 
 
+      void backGlyphObj(Core::String glyph, Core::FastU val);
+
       virtual void chk();
       virtual void chkBlock();
               void chkBlock(IR::Block &block);
@@ -228,6 +235,10 @@ namespace GDCC::BC
       virtual void genStrEnt() {}
               void genStrEnt(IR::StrEnt &strent);
 
+      virtual void inl();
+      virtual void inlFunc();
+              void inlFunc(IR::Function &func);
+
       virtual void opt();
       virtual void optBlock();
               void optBlock(IR::Block &block);
@@ -260,6 +271,9 @@ namespace GDCC::BC
       virtual void preStrEnt() {}
               void preStrEnt(IR::StrEnt &strent);
 
+      virtual void prof();
+              void profBack();
+
       virtual void put() = 0;
       virtual void putBlock();
               void putBlock(IR::Block &block);
@@ -371,6 +385,8 @@ namespace GDCC::BC
 
       virtual FixedInfo getIntegInfo(Core::FastU n, bool s);
 
+      bool getLocRegIdx(IR::Arg_LocReg const &arg, Core::FastU &idx);
+
       virtual Core::FastU getStmntSize();
 
       Core::FastU getWord(IR::Arg_Lit const &arg, Core::FastU w = 0);
@@ -381,6 +397,8 @@ namespace GDCC::BC
       virtual Core::FastU getWord_Fixed(IR::Value_Fixed const &val, Core::FastU w);
       virtual Core::FastU getWord_Float(IR::Value_Float const &val, Core::FastU w);
 
+      bool getWordPow2(IR::Arg const &arg, Core::FastU words, Core::FastU &bit);
+
       Core::FastU getWordCount(IR::Type const &type);
       Core::FastU getWordCount_Assoc(IR::Type_Assoc const &type);
       virtual Core::FastU getWordCount_Point(IR::Type_Point const &type);
@@ -403,13 +421,25 @@ namespace GDCC::BC
 
       void putData(char const *data, std::size_t size);
 
+      bool inlFuncCheck(IR::Function &callee);
+
+      bool inlStmnt_Call(Core::String label, Core::FastU base);
+
       void moveArgStk_dst(IR::Arg &idx);
       void moveArgStk_src(IR::Arg &idx);
 
+      bool optFunc_LocReg();
+
+      bool optStmnt_Call_Retn();
       bool optStmnt_Cspe_Drop();
       bool optStmnt_JumpNext();
       bool optStmnt_LNot_Jcnd();
 
+      bool preStmntConst();
+      bool preStmntConst_Div();
+      bool preStmntConst_Mod();
+      bool preStmntConst_Mul();
+
       void trStmntStk2();
       void trStmntStk3(bool ordered);
       bool trStmntShift(bool moveLit);
@@ -425,6 +455,8 @@ namespace GDCC::BC
       IR::StrEnt    *strent;
       std::size_t    putPos;
 
+      std::vector<IR::Function *> funcPend;
+
    private:
       void addFunc_Add_UW(Core::FastU n, IR::Code codeAdd, IR::Code codeAdX);
       void addFunc_Bclz_W(Core::FastU n, IR::Code code, Core::FastU skip);
@@ -12,6 +12,10 @@
 
 #include "BC/Info.hpp"
 
+#include "BC/HelperLib.hpp"
+
+#include "Core/Stats.hpp"
+
 #include "IR/Exception.hpp"
 #include "IR/Linkage.hpp"
 #include "IR/Program.hpp"
@@ -43,7 +47,8 @@ namespace GDCC::BC
 
          prog->getGlyphData(name).type = IR::Type_Funct(newFn.ctype);
 
-         // Signal iterator to start over.
+         // Queue for the current pass and signal the caller to retry.
+         funcPend.push_back(&newFn);
          throw ResetFunc();
       }
    }
@@ -62,12 +67,18 @@ namespace GDCC::BC
       if(newFunc->defin)
          return nullptr;
 
+      // Use the prebuilt definition, if any.
+      if(HelperLoad(*prog, name))
+         return nullptr;
+
       newFunc->defin    = true;
       newFunc->label    = name + "$label";
       newFunc->localReg = localReg;
 
       newFunc->block.setOrigin({file, 0});
 
+      Core::StatAdd(Core::StatCount::Helpers);
+
       return newFunc;
    }
 
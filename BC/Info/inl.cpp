@@ -0,0 +1,517 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Function inlining.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "BC/Profile.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Function.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/Int.hpp"
+
+#include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-inline-hot-stmnts
+   //
+   static Option::Int<Core::FastU> InlineHotStmnts
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-inline-hot-stmnts")
+         .setGroup("codegen")
+         .setDescS("Sets the statement budget for inlining hot calls.")
+         .setDescL("Sets the statement budget for inlining calls made by or "
+            "to functions that are hot in the data from --profile-use. With "
+            "profile data, other calls are not inlined. Default is 40."),
+
+      40
+   };
+
+   //
+   // --bc-inline-stmnts
+   //
+   static Option::Int<Core::FastU> InlineStmnts
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-inline-stmnts")
+         .setGroup("codegen")
+         .setDescS("Sets the statement budget for function inlining.")
+         .setDescL("Sets the statement budget for function inlining. A call "
+            "is only inlined if the called function's body, less the "
+            "statements made redundant by inlining, is at most this many "
+            "statements. Inlining is performed by the inl IR processing "
+            "step. Default is 8."),
+
+      8
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GetGlyph
+   //
+   // Returns the glyph named by a literal argument, if any.
+   //
+   static Core::String GetGlyph(IR::Arg const &arg)
+   {
+      if(arg.a != IR::ArgBase::Lit || arg.aLit.off)
+         return Core::STRNULL;
+
+      if(auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*arg.aLit.value))
+         return exp->glyph;
+
+      return Core::STRNULL;
+   }
+
+   //
+   // IsInlineCallArg
+   //
+   // Checks if an argument of the call statement can be used as-is by the
+   // statements replacing the call.
+   //
+   static bool IsInlineCallArg(IR::Arg const &arg)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Lit:
+      case IR::ArgBase::Nul:
+      case IR::ArgBase::Stk:
+         return true;
+
+      case IR::ArgBase::LocReg:
+         return arg.aLocReg.idx->a == IR::ArgBase::Lit;
+
+      default:
+         return false;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::inl
+   //
+   void Info::inl()
+   {
+      for(auto &itr : prog->rangeFunction())
+         inlFunc(itr);
+   }
+
+   //
+   // Info::inlFunc
+   //
+   void Info::inlFunc()
+   {
+      if(!func->defin)
+         return;
+
+      // Inlined registers are placed after the caller's, which would move an
+      // auto stack pointer kept in the last register.
+      if(func->allocAut && !Target::IsCallAutoProp(func->ctype))
+         return;
+
+      std::unordered_set<Core::String> labels;
+      for(auto const &st : func->block)
+         for(auto const &lab : st.labs)
+            labels.insert(lab);
+
+      // Every inlined call shares the same registers after the caller's, as
+      // they are never active together.
+      Core::FastU base = std::max(func->localReg, func->param);
+
+      Core::FastU n = 0;
+      auto        end = static_cast<IR::Statement *>(func->block.end());
+
+      for(stmnt = static_cast<IR::Statement *>(func->block.begin()); stmnt != end;)
+      {
+         auto next = stmnt->next;
+
+         if(stmnt->code.base == IR::CodeBase::Call)
+         {
+            Core::String label;
+            do label = func->glyph + "$inl" + std::to_string(n++).c_str();
+            while(labels.count(label));
+
+            inlStmnt_Call(label, base);
+         }
+
+         stmnt = next;
+      }
+
+      stmnt = nullptr;
+   }
+
+   //
+   // Info::inlFuncCheck
+   //
+   // Checks if a function can be inlined and is within the inlining budget.
+   //
+   bool Info::inlFuncCheck(IR::Function &callee)
+   {
+      if(!callee.defin || callee.allocAut || callee.block.empty())
+         return false;
+
+      // With profile data, only calls made by or to hot functions.
+      Core::FastU budget = InlineStmnts;
+      if(ProfileIsUsed())
+      {
+         if(!ProfileIsHot(func->glyph) && !ProfileIsHot(callee.glyph))
+            return false;
+
+         budget = InlineHotStmnts;
+      }
+
+      // Only functions using the normal call mechanism. Scripts and native
+      // functions have side effects beyond their block.
+      switch(callee.ctype)
+      {
+      case IR::CallType::StdCall:
+      case IR::CallType::StkCall:
+         break;
+
+      default:
+         return false;
+      }
+
+      Core::FastU wb       = Target::GetWordBytes();
+      Core::FastU localMax = std::max(callee.localReg, callee.param);
+
+      auto checkArg = [&](auto &self, IR::Arg const &arg) -> bool
+      {
+         switch(arg.a)
+         {
+         case IR::ArgBase::LocReg:
+         {
+            auto &a = arg.aLocReg;
+
+            Core::FastU idx;
+            if(!getLocRegIdx(a, idx))
+               return false;
+
+            return idx % wb == 0 && a.size % wb == 0 &&
+               idx / wb + a.size / wb <= localMax;
+         }
+
+            // Storage tied to the callee's frame.
+         case IR::ArgBase::Aut:
+         case IR::ArgBase::LocArr:
+         case IR::ArgBase::Vaa:
+            return false;
+
+         case IR::ArgBase::Gen:    return self(self, *arg.aGen.idx);
+         case IR::ArgBase::Far:    return self(self, *arg.aFar.idx);
+         case IR::ArgBase::GblArs: return self(self, *arg.aGblArs.idx);
+         case IR::ArgBase::GblReg: return self(self, *arg.aGblReg.idx);
+         case IR::ArgBase::HubArs: return self(self, *arg.aHubArs.idx);
+         case IR::ArgBase::HubReg: return self(self, *arg.aHubReg.idx);
+         case IR::ArgBase::ModArs: return self(self, *arg.aModArs.idx);
+         case IR::ArgBase::ModReg: return self(self, *arg.aModReg.idx);
+         case IR::ArgBase::Sta:    return self(self, *arg.aSta.idx);
+         case IR::ArgBase::StrArs: return self(self, *arg.aStrArs.idx);
+
+         case IR::ArgBase::GblArr:
+            return self(self, *arg.aGblArr.arr) && self(self, *arg.aGblArr.idx);
+         case IR::ArgBase::HubArr:
+            return self(self, *arg.aHubArr.arr) && self(self, *arg.aHubArr.idx);
+         case IR::ArgBase::ModArr:
+            return self(self, *arg.aModArr.arr) && self(self, *arg.aModArr.idx);
+         case IR::ArgBase::StrArr:
+            return self(self, *arg.aStrArr.arr) && self(self, *arg.aStrArr.idx);
+
+         default:
+            return true;
+         }
+      };
+
+      Core::FastU size = 0;
+
+      for(auto const &st : callee.block)
+      {
+         switch(st.code.base)
+         {
+            // Only leaf functions are inlined, which also rules out recursion.
+            // Other statements either use the call frame or jump outside of
+            // the block.
+         case IR::CodeBase::Call:
+         case IR::CodeBase::Casm:
+         case IR::CodeBase::Jdyn:
+         case IR::CodeBase::Jfar_Pro:
+         case IR::CodeBase::Jfar_Set:
+         case IR::CodeBase::Jfar_Sta:
+         case IR::CodeBase::Pltn:
+         case IR::CodeBase::Rjnk:
+         case IR::CodeBase::Xcod_SID:
+            return false;
+
+         case IR::CodeBase::Nop:
+            continue;
+
+         case IR::CodeBase::Retn:
+            if(st.args.size() > 1)
+               return false;
+
+            if((st.args.empty() ? 0 : st.args[0].getSize()) != callee.retrn * wb)
+               return false;
+
+            break;
+
+         default:
+            break;
+         }
+
+         for(auto const &arg : st.args)
+            if(!checkArg(checkArg, arg)) return false;
+
+         ++size;
+      }
+
+      // Control must not reach the end of the block.
+      auto last = callee.block.end();
+      if((--last)->code.base != IR::CodeBase::Retn)
+         return false;
+
+      // The final return becomes a fall through to the call's successor.
+      return size - 1 <= budget;
+   }
+
+   //
+   // Info::inlStmnt_Call
+   //
+   // Replaces a call with the called function's block, using label as the
+   // prefix for any needed labels and placing its registers at base.
+   //
+   bool Info::inlStmnt_Call(Core::String label, Core::FastU base)
+   {
+      auto calleeName = GetGlyph(stmnt->args[1]);
+      if(!calleeName)
+         return false;
+
+      auto callee = prog->findFunction(calleeName);
+      if(!callee || callee == func || !inlFuncCheck(*callee))
+         return false;
+
+      Core::FastU wb = Target::GetWordBytes();
+
+      // Check call arguments.
+      Core::FastU paramSize = 0;
+      for(std::size_t i = 2, e = stmnt->args.size(); i != e; ++i)
+      {
+         auto const &arg = stmnt->args[i];
+
+         if(!IsInlineCallArg(arg) || arg.getSize() % wb)
+            return false;
+
+         paramSize += arg.getSize();
+      }
+
+      if(paramSize != callee->param * wb)
+         return false;
+
+      // With profile data, only calls no slower once inlined. Each argument
+      // word takes a move, in place of the call and return.
+      if(ProfileIsUsed() && paramSize / wb > 2)
+         return false;
+
+      auto const &dst = stmnt->args[0];
+      if(dst.a == IR::ArgBase::Lit || !IsInlineCallArg(dst))
+         return false;
+
+      Core::FastU retnSize = dst.a == IR::ArgBase::Nul ? 0 : dst.getSize();
+      if(retnSize && retnSize != callee->retrn * wb)
+         return false;
+
+      // The end label needs a statement to be attached to.
+      auto next = stmnt->next;
+      if(next == static_cast<IR::Statement *>(func->block.end()))
+         return false;
+
+      Core::FastU regs     = std::max(callee->localReg, callee->param);
+      Core::FastU localReg = std::max(func->localReg, base + regs);
+
+      // Keep within the smallest native frame limit.
+      if(localReg + func->localTmp > 255)
+         return false;
+
+      auto &blk = func->block;
+
+      // Labels pending for the next added statement.
+      std::vector<Core::String> labs{stmnt->labs.begin(), stmnt->labs.end()};
+
+      auto addStmnt = [&](Core::Origin pos, IR::Code code, Core::Array<IR::Arg> &&args)
+      {
+         blk.setOrigin(pos);
+         for(auto const &lab : labs)
+            blk.addLabel(lab);
+         labs.clear();
+         blk.addStmntArgs(stmnt, code, std::move(args));
+      };
+
+      auto getLocReg = [&](Core::FastU word, Core::FastU size) -> IR::Arg
+      {
+         return IR::Arg_LocReg(size, IR::Arg_Lit(wb, blk.getExp((base + word) * wb)));
+      };
+
+      // Move arguments into the callee's parameter registers. The last
+      // argument is moved first so that stack arguments pop in order.
+      for(std::size_t i = stmnt->args.size(), word = callee->param; i-- != 2;)
+      {
+         auto const &arg  = stmnt->args[i];
+         auto        size = arg.getSize();
+
+         word -= size / wb;
+
+         if(size)
+            addStmnt(stmnt->pos, IR::CodeBase::Move, {getLocReg(word, size), arg});
+      }
+
+      // Map the callee's labels to new ones.
+      std::unordered_map<Core::String, Core::String> labelMap;
+      for(auto const &st : callee->block)
+         for(auto const &lab : st.labs)
+            labelMap.emplace(lab, label + "$" + lab);
+
+      auto remapArg = [&](auto &self, IR::Arg &arg) -> void
+      {
+         switch(arg.a)
+         {
+         case IR::ArgBase::LocReg:
+         {
+            auto &a = arg.aLocReg;
+
+            Core::FastU idx;
+            getLocRegIdx(a, idx);
+
+            auto word = idx / wb;
+            *a.idx = IR::Arg_Lit(a.idx->aLit.size, blk.getExp((base + word) * wb));
+            a.off  = 0;
+         }
+            break;
+
+         case IR::ArgBase::Lit:
+            if(auto lab = GetGlyph(arg))
+            {
+               auto itr = labelMap.find(lab);
+               if(itr != labelMap.end())
+                  arg = IR::Arg_Lit(arg.aLit.size, blk.getExp(IR::Glyph(prog, itr->second)));
+            }
+            break;
+
+         case IR::ArgBase::Gen:    self(self, *arg.aGen.idx);    break;
+         case IR::ArgBase::Far:    self(self, *arg.aFar.idx);    break;
+         case IR::ArgBase::GblArs: self(self, *arg.aGblArs.idx); break;
+         case IR::ArgBase::GblReg: self(self, *arg.aGblReg.idx); break;
+         case IR::ArgBase::HubArs: self(self, *arg.aHubArs.idx); break;
+         case IR::ArgBase::HubReg: self(self, *arg.aHubReg.idx); break;
+         case IR::ArgBase::ModArs: self(self, *arg.aModArs.idx); break;
+         case IR::ArgBase::ModReg: self(self, *arg.aModReg.idx); break;
+         case IR::ArgBase::Sta:    self(self, *arg.aSta.idx);    break;
+         case IR::ArgBase::StrArs: self(self, *arg.aStrArs.idx); break;
+
+         case IR::ArgBase::GblArr:
+            self(self, *arg.aGblArr.arr); self(self, *arg.aGblArr.idx); break;
+         case IR::ArgBase::HubArr:
+            self(self, *arg.aHubArr.arr); self(self, *arg.aHubArr.idx); break;
+         case IR::ArgBase::ModArr:
+            self(self, *arg.aModArr.arr); self(self, *arg.aModArr.idx); break;
+         case IR::ArgBase::StrArr:
+            self(self, *arg.aStrArr.arr); self(self, *arg.aStrArr.idx); break;
+
+         default:
+            break;
+         }
+      };
+
+      // Copy the callee's statements.
+      bool labelUsed = false;
+      for(auto itr = callee->block.begin(), end = callee->block.end(); itr != end; ++itr)
+      {
+         for(auto const &lab : itr->labs)
+            labs.push_back(labelMap[lab]);
+
+         Core::Array<IR::Arg> args(itr->args);
+         for(auto &arg : args)
+            remapArg(remapArg, arg);
+
+         if(itr->code.base != IR::CodeBase::Retn)
+         {
+            addStmnt(itr->pos, itr->code, std::move(args));
+            continue;
+         }
+
+         // Returns move the result to the call's destination, then jump to
+         // the end of the inlined block.
+         if(!args.empty())
+         {
+            auto &src = args[0];
+
+            if(!retnSize)
+            {
+               if(src.a == IR::ArgBase::Stk)
+                  addStmnt(itr->pos, IR::CodeBase::Move, {IR::Arg_Nul(src.getSize()), src});
+            }
+            else if(dst.a != IR::ArgBase::Stk || src.a != IR::ArgBase::Stk)
+               addStmnt(itr->pos, IR::CodeBase::Move, {dst, src});
+         }
+
+         if(std::next(itr) != end)
+         {
+            addStmnt(itr->pos, IR::CodeBase::Jump,
+               {IR::Arg_Lit(wb, blk.getExp(IR::Glyph(prog, label)))});
+            labelUsed = true;
+         }
+      }
+
+      // Any remaining labels, and the end label, go on the call's successor.
+      if(labelUsed)
+         labs.push_back(label);
+
+      if(!labs.empty())
+         next->labs += Core::Array<Core::String>(labs.begin(), labs.end());
+
+      delete stmnt;
+
+      func->localReg = localReg;
+
+      return true;
+   }
+}
+
+// EOF
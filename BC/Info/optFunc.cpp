@@ -0,0 +1,640 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Generic function optimizations.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Function.hpp"
+
+#include "Option/Bool.hpp"
+
+#include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-opt-locreg
+   //
+   static Option::Bool OptLocReg
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-locreg")
+         .setGroup("codegen")
+         .setDescS("Enables or disables local register packing.")
+         .setDescL("Enables or disables local register packing. When "
+            "enabled, local registers and temporaries whose lifetimes do not "
+            "overlap are assigned to the same register, reducing the number "
+            "of registers each call must allocate. Default on."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // LocRegRef
+   //
+   // A single reference to a range of local register words.
+   //
+   class LocRegRef
+   {
+   public:
+      IR::ArgPtr1 *arg;
+      Core::FastU  lo, hi;
+      std::size_t  stmnt;
+      std::size_t  unit;
+      bool         def : 1;
+      bool         use : 1;
+   };
+
+   //
+   // LocRegSet
+   //
+   // Dense bit set over allocation units.
+   //
+   class LocRegSet
+   {
+   public:
+      explicit LocRegSet(std::size_t n = 0) : bits((n + 63) / 64, 0) {}
+
+      bool assignUnion(LocRegSet const &set)
+      {
+         bool changed = false;
+         for(std::size_t i = 0, e = bits.size(); i != e; ++i)
+         {
+            auto word = bits[i] | set.bits[i];
+            if(word != bits[i]) bits[i] = word, changed = true;
+         }
+         return changed;
+      }
+
+      template<typename Fn>
+      void forEach(Fn &&fn) const
+      {
+         for(std::size_t i = 0, e = bits.size(); i != e; ++i)
+            for(auto word = bits[i]; word; word &= word - 1)
+               fn(i * 64 + Ctz(word));
+      }
+
+      void reset(std::size_t i) {bits[i / 64] &= ~(std::uint64_t(1) << (i % 64));}
+
+      void set(std::size_t i) {bits[i / 64] |= std::uint64_t(1) << (i % 64);}
+
+   private:
+      static std::size_t Ctz(std::uint64_t word)
+      {
+         std::size_t n = 0;
+         while(!(word & 1)) word >>= 1, ++n;
+         return n;
+      }
+
+      std::vector<std::uint64_t> bits;
+   };
+
+   //
+   // LocRegUnit
+   //
+   // A contiguous range of local register words that must be moved as one.
+   //
+   class LocRegUnit
+   {
+   public:
+      Core::FastU lo, hi;
+      Core::FastU color;
+
+      bool fixed  : 1;
+      bool global : 1;
+      bool stkPtr : 1;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // IsLocRegTopStkPtr
+   //
+   // Checks if the function keeps its auto stack pointer in the last local
+   // register, rather than in the first parameter.
+   //
+   static bool IsLocRegTopStkPtr(IR::Function const *func)
+   {
+      if(!func->allocAut)
+         return false;
+
+      switch(func->ctype)
+      {
+      case IR::CallType::ScriptI:
+      case IR::CallType::ScriptS:
+      case IR::CallType::StkCall:
+         return true;
+
+      default:
+         return false;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::optFunc
+   //
+   void Info::optFunc()
+   {
+      optBlock(func->block);
+
+      if(OptLocReg)
+         optFunc_LocReg();
+   }
+
+   //
+   // Info::optFunc_LocReg
+   //
+   // Performs liveness analysis over local registers and reassigns them so
+   // that registers with disjoint lifetimes share the same index. Parameters
+   // keep their indexes, but their registers may be reused once dead.
+   //
+   bool Info::optFunc_LocReg()
+   {
+      if(!func->defin || func->block.empty())
+         return false;
+
+      Core::FastU wb = Target::GetWordBytes();
+
+      std::vector<IR::Statement *>                  stmnts;
+      std::unordered_map<Core::String, std::size_t> labels;
+      std::vector<LocRegRef>                        refs;
+
+      Core::FastU localMax = std::max(func->localReg, func->param);
+
+      // Adds references for an arg and any args it uses for addressing.
+      std::size_t stmntIdx;
+      auto addRef = [&](auto &self, IR::Arg &arg, bool def, bool use) -> bool
+      {
+         switch(arg.a)
+         {
+         case IR::ArgBase::LocReg:
+         {
+            auto &a = arg.aLocReg;
+
+            Core::FastU idx;
+            if(!getLocRegIdx(a, idx))
+               return false;
+
+            if(a.size == 0)
+               return true;
+
+            if(idx % wb || a.size % wb)
+               return false;
+
+            LocRegRef ref;
+            ref.arg   = &a;
+            ref.lo    = idx / wb;
+            ref.hi    = ref.lo + a.size / wb;
+            ref.stmnt = stmntIdx;
+            ref.unit  = 0;
+            ref.def   = def;
+            ref.use   = use;
+
+            if(ref.hi > localMax)
+               return false;
+
+            refs.push_back(ref);
+            return true;
+         }
+
+         case IR::ArgBase::Gen:    return self(self, *arg.aGen.idx,    false, true);
+         case IR::ArgBase::Aut:    return self(self, *arg.aAut.idx,    false, true);
+         case IR::ArgBase::Far:    return self(self, *arg.aFar.idx,    false, true);
+         case IR::ArgBase::GblArs: return self(self, *arg.aGblArs.idx, false, true);
+         case IR::ArgBase::GblReg: return self(self, *arg.aGblReg.idx, false, true);
+         case IR::ArgBase::HubArs: return self(self, *arg.aHubArs.idx, false, true);
+         case IR::ArgBase::HubReg: return self(self, *arg.aHubReg.idx, false, true);
+         case IR::ArgBase::ModArs: return self(self, *arg.aModArs.idx, false, true);
+         case IR::ArgBase::ModReg: return self(self, *arg.aModReg.idx, false, true);
+         case IR::ArgBase::Sta:    return self(self, *arg.aSta.idx,    false, true);
+         case IR::ArgBase::StrArs: return self(self, *arg.aStrArs.idx, false, true);
+         case IR::ArgBase::Vaa:    return self(self, *arg.aVaa.idx,    false, true);
+
+         case IR::ArgBase::GblArr:
+            return self(self, *arg.aGblArr.arr, false, true) &&
+                   self(self, *arg.aGblArr.idx, false, true);
+         case IR::ArgBase::HubArr:
+            return self(self, *arg.aHubArr.arr, false, true) &&
+                   self(self, *arg.aHubArr.idx, false, true);
+         case IR::ArgBase::LocArr:
+            return self(self, *arg.aLocArr.arr, false, true) &&
+                   self(self, *arg.aLocArr.idx, false, true);
+         case IR::ArgBase::ModArr:
+            return self(self, *arg.aModArr.arr, false, true) &&
+                   self(self, *arg.aModArr.idx, false, true);
+         case IR::ArgBase::StrArr:
+            return self(self, *arg.aStrArr.arr, false, true) &&
+                   self(self, *arg.aStrArr.idx, false, true);
+
+         default:
+            return true;
+         }
+      };
+
+      // Collect statements, labels, and register references.
+      for(auto &st : func->block)
+      {
+         stmntIdx = stmnts.size();
+         stmnts.push_back(&st);
+
+         for(auto const &lab : st.labs)
+            labels.emplace(lab, stmntIdx);
+
+         std::size_t argDst;
+         bool        argDstUse = false;
+         bool        allDstUse = false;
+
+         switch(st.code.base)
+         {
+            // Statements which may access registers implicitly or alter
+            // control flow non-locally.
+         case IR::CodeBase::Casm:
+         case IR::CodeBase::Jfar_Pro:
+         case IR::CodeBase::Jfar_Set:
+         case IR::CodeBase::Jfar_Sta:
+            return false;
+
+            // Statements with no destination.
+         case IR::CodeBase::Jcnd_Nil:
+         case IR::CodeBase::Jcnd_Tab:
+         case IR::CodeBase::Jcnd_Tru:
+         case IR::CodeBase::Jdyn:
+         case IR::CodeBase::Jump:
+         case IR::CodeBase::Nop:
+         case IR::CodeBase::Retn:
+         case IR::CodeBase::Rjnk:
+         case IR::CodeBase::Xcod_SID:
+            argDst = st.args.size();
+            break;
+
+            // Statements which read and write their operands.
+         case IR::CodeBase::Copy:
+         case IR::CodeBase::Swap:
+            argDst = 0;
+            allDstUse = true;
+            break;
+
+            // Statements which only partially write their destination.
+         case IR::CodeBase::Bset:
+            argDst    = 0;
+            argDstUse = true;
+            break;
+
+         default:
+            argDst = 0;
+            break;
+         }
+
+         for(std::size_t i = 0, e = st.args.size(); i != e; ++i)
+         {
+            bool def = allDstUse || i == argDst;
+            bool use = allDstUse || i != argDst || argDstUse;
+
+            if(!addRef(addRef, st.args[i], def, use))
+               return false;
+         }
+      }
+
+      // Parameter registers are written by the caller.
+      std::vector<LocRegUnit> units;
+      for(Core::FastU i = 0; i != func->param; ++i)
+         units.push_back({i, i + 1, i, true, false, false});
+
+      for(auto const &ref : refs)
+         units.push_back({ref.lo, ref.hi, 0, false, false, false});
+
+      if(units.empty())
+         return false;
+
+      // Merge overlapping ranges into allocation units.
+      std::sort(units.begin(), units.end(),
+         [](LocRegUnit const &l, LocRegUnit const &r) {return l.lo < r.lo;});
+
+      {
+         std::size_t n = 0;
+         for(std::size_t i = 1, e = units.size(); i != e; ++i)
+         {
+            auto &unit = units[n];
+
+            if(units[i].lo < unit.hi)
+            {
+               unit.hi    = std::max(unit.hi, units[i].hi);
+               unit.fixed = unit.fixed || units[i].fixed;
+            }
+            else
+               units[++n] = units[i];
+         }
+         units.resize(n + 1);
+
+         for(auto &unit : units)
+            unit.color = unit.lo;
+      }
+
+      // Finds the unit containing a word.
+      auto findUnit = [&](Core::FastU word)
+      {
+         return std::upper_bound(units.begin(), units.end(), word,
+            [](Core::FastU w, LocRegUnit const &u) {return w < u.lo;})
+            - units.begin() - 1;
+      };
+
+      for(auto &ref : refs)
+         ref.unit = findUnit(ref.lo);
+
+      // Registers used implicitly by the target for the auto stack pointer.
+      bool topStkPtr = IsLocRegTopStkPtr(func);
+
+      if(Target::IsCallAutoProp(func->ctype))
+      {
+         if(func->param)
+            units[findUnit(0)].global = true;
+      }
+
+      if(topStkPtr)
+      {
+         if(func->localReg == 0 || func->localReg <= func->param)
+            return false;
+
+         Core::FastU spWord = func->localReg - 1;
+         auto        spUnit = findUnit(spWord);
+
+         if(spUnit >= 0 && units[spUnit].lo <= spWord && spWord < units[spUnit].hi)
+         {
+            if(units[spUnit].lo != spWord || units[spUnit].hi != spWord + 1)
+               return false;
+
+            units[spUnit].global = true;
+            units[spUnit].stkPtr = true;
+         }
+      }
+
+      std::size_t unitC = units.size();
+
+      // Bound memory use for extremely large functions.
+      if(unitC > 4096)
+         return false;
+
+      // Per-statement use and kill sets.
+      std::size_t stmntC = stmnts.size();
+
+      std::vector<LocRegSet> use (stmntC, LocRegSet(unitC));
+      std::vector<LocRegSet> kill(stmntC, LocRegSet(unitC));
+
+      for(auto const &ref : refs)
+      {
+         auto const &unit = units[ref.unit];
+
+         if(ref.use)
+            use[ref.stmnt].set(ref.unit);
+         else if(ref.def && ref.lo == unit.lo && ref.hi == unit.hi)
+            kill[ref.stmnt].set(ref.unit);
+      }
+
+      for(std::size_t i = 0; i != stmntC; ++i)
+         use[i].forEach([&](std::size_t u) {kill[i].reset(u);});
+
+      // Control flow successors.
+      std::vector<std::size_t> labelAll;
+      for(std::size_t i = 0; i != stmntC; ++i)
+         if(!stmnts[i]->labs.empty()) labelAll.push_back(i);
+
+      std::vector<std::vector<std::size_t>> succ(stmntC);
+
+      auto addJump = [&](std::size_t i, IR::Arg const &arg)
+      {
+         if(arg.a == IR::ArgBase::Lit)
+         {
+            if(auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*arg.aLit.value))
+            {
+               auto itr = labels.find(static_cast<Core::String>(exp->glyph));
+               if(itr != labels.end())
+               {
+                  succ[i].push_back(itr->second);
+                  return;
+               }
+            }
+         }
+
+         // Unknown target, so assume any label.
+         succ[i].insert(succ[i].end(), labelAll.begin(), labelAll.end());
+      };
+
+      for(std::size_t i = 0; i != stmntC; ++i)
+      {
+         auto &st = *stmnts[i];
+
+         switch(st.code.base)
+         {
+         case IR::CodeBase::Jcnd_Nil:
+         case IR::CodeBase::Jcnd_Tru:
+            addJump(i, st.args[1]);
+            break;
+
+         case IR::CodeBase::Jcnd_Tab:
+            for(std::size_t a = 2, e = st.args.size(); a < e; a += 2)
+               addJump(i, st.args[a]);
+            break;
+
+         case IR::CodeBase::Jdyn:
+            succ[i] = labelAll;
+            continue;
+
+         case IR::CodeBase::Jump:
+            addJump(i, st.args[0]);
+            continue;
+
+         case IR::CodeBase::Retn:
+         case IR::CodeBase::Rjnk:
+            continue;
+
+         default:
+            break;
+         }
+
+         if(i + 1 != stmntC)
+            succ[i].push_back(i + 1);
+      }
+
+      // Iterate liveness to fixed point.
+      std::vector<LocRegSet> liveIn (stmntC, LocRegSet(unitC));
+      std::vector<LocRegSet> liveOut(stmntC, LocRegSet(unitC));
+
+      for(std::size_t i = 0; i != stmntC; ++i)
+         liveIn[i] = use[i];
+
+      for(bool changed = true; changed;)
+      {
+         changed = false;
+
+         for(std::size_t i = stmntC; i--;)
+         {
+            for(auto s : succ[i])
+               liveOut[i].assignUnion(liveIn[s]);
+
+            LocRegSet in = liveOut[i];
+            kill[i].forEach([&](std::size_t u) {in.reset(u);});
+            if(liveIn[i].assignUnion(in))
+               changed = true;
+         }
+      }
+
+      // Build interference.
+      std::vector<LocRegSet> inter(unitC, LocRegSet(unitC));
+
+      auto addInter = [&](std::size_t l, std::size_t r)
+      {
+         if(l != r) inter[l].set(r), inter[r].set(l);
+      };
+
+      for(std::size_t i = 0; i != unitC; ++i)
+      {
+         if(units[i].global)
+            for(std::size_t j = 0; j != unitC; ++j) addInter(i, j);
+      }
+
+      {
+         // All registers live on entry are defined simultaneously.
+         LocRegSet entry = liveIn[0];
+         for(std::size_t i = 0; i != unitC; ++i)
+            if(units[i].fixed) entry.set(i);
+
+         entry.forEach([&](std::size_t l)
+            {entry.forEach([&](std::size_t r) {addInter(l, r);});});
+      }
+
+      // References are in statement order, so each statement's are adjacent.
+      for(std::size_t b = 0, e, refC = refs.size(); b != refC; b = e)
+      {
+         for(e = b + 1; e != refC && refs[e].stmnt == refs[b].stmnt;) ++e;
+
+         for(std::size_t r = b; r != e; ++r)
+         {
+            auto const &ref = refs[r];
+
+            if(!ref.def)
+               continue;
+
+            // Written registers interfere with everything live after.
+            liveOut[ref.stmnt].forEach([&](std::size_t u) {addInter(ref.unit, u);});
+
+            // And with every other register in the same statement, so that
+            // operands are never newly aliased.
+            for(std::size_t o = b; o != e; ++o)
+               addInter(ref.unit, refs[o].unit);
+         }
+      }
+
+      // Assign registers, keeping parameters in place.
+      std::vector<bool> done(unitC, false);
+      Core::FastU       localNew = func->param;
+
+      for(std::size_t i = 0; i != unitC; ++i)
+      {
+         if(units[i].fixed)
+         {
+            done[i]  = true;
+            localNew = std::max(localNew, units[i].hi);
+         }
+      }
+
+      for(std::size_t i = 0; i != unitC; ++i)
+      {
+         auto &unit = units[i];
+
+         if(done[i] || unit.stkPtr)
+            continue;
+
+         std::vector<std::pair<Core::FastU, Core::FastU>> used;
+         inter[i].forEach([&](std::size_t o)
+         {
+            if(done[o])
+               used.emplace_back(units[o].color, units[o].color + units[o].hi - units[o].lo);
+         });
+
+         std::sort(used.begin(), used.end());
+
+         Core::FastU color = 0, size = unit.hi - unit.lo;
+         for(auto const &u : used)
+         {
+            if(color + size <= u.first) break;
+            color = std::max(color, u.second);
+         }
+
+         unit.color = color;
+         done[i]    = true;
+         localNew   = std::max(localNew, color + size);
+      }
+
+      if(topStkPtr)
+      {
+         for(auto &unit : units)
+            if(unit.stkPtr) unit.color = localNew;
+
+         ++localNew;
+      }
+
+      // Only rewrite if it actually reduces the register count.
+      if(localNew >= func->localReg)
+         return false;
+
+      for(auto const &ref : refs)
+      {
+         auto const &unit = units[ref.unit];
+
+         auto idx = (unit.color + (ref.lo - unit.lo)) * wb;
+         auto len = ref.arg->idx->aLit.size;
+
+         *ref.arg->idx = IR::Arg_Lit(len, func->block.getExp(idx));
+         ref.arg->off = 0;
+      }
+
+      func->localReg = localNew;
+
+      return true;
+   }
+}
+
+// EOF
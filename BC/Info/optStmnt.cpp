@@ -15,10 +15,15 @@
 #include "Core/Option.hpp"
 
 #include "IR/Exp/Glyph.hpp"
+#include "IR/Function.hpp"
+#include "IR/Program.hpp"
 #include "IR/Statement.hpp"
 
 #include "Option/Bool.hpp"
 
+#include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
 #include <algorithm>
 
 
@@ -57,11 +62,187 @@ namespace GDCC::BC
       if(!OptPass)
          return;
 
+      optStmnt_Call_Retn();
       optStmnt_Cspe_Drop();
       optStmnt_JumpNext();
       optStmnt_LNot_Jcnd();
    }
 
+   //
+   // Info::optStmnt_Call_Retn
+   //
+   // The sequence:
+   //    Call(Stk N() Lit("func") ...)
+   //    Jfar_Pro(Lit(...) Stk N()) (optional)
+   //    Retn(Stk N())
+   // Where "func" is the current function, can be transformed into:
+   //    Move(LocReg(...) ...)
+   //    Jump(Lit("func$tail"))
+   //    Retn(Stk N())
+   //
+   bool Info::optStmnt_Call_Retn()
+   {
+      // Must be Call(... Lit("func") ...).
+      if(stmnt->code != IR::CodeBase::Call || stmnt->args[1].a != IR::ArgBase::Lit ||
+         stmnt->args[1].aLit.off)
+         return false;
+
+      auto callExp = dynamic_cast<IR::Exp_Glyph const *>(&*stmnt->args[1].aLit.value);
+      if(!callExp || callExp->glyph != func->glyph)
+         return false;
+
+      // Only functions whose entire frame is in registers can reuse it. An
+      // address of an auto or local array may be one of the arguments.
+      switch(func->ctype)
+      {
+      case IR::CallType::StdCall:
+      case IR::CallType::StkCall:
+         break;
+
+      default:
+         return false;
+      }
+
+      if(func->allocAut || func->localAut || !func->localArr.empty())
+         return false;
+
+      auto const &dst = stmnt->args[0];
+
+      auto next = stmnt->next;
+
+      // Long jump propagation is not needed without the call.
+      IR::Statement *jfar = nullptr;
+      if(next->code == IR::CodeBase::Jfar_Pro)
+      {
+         if(!next->labs.empty() || next->args[1] != dst)
+            return false;
+
+         jfar = next;
+         next = next->next;
+      }
+
+      // Must be followed by Retn of the call's result.
+      if(next->code != IR::CodeBase::Retn || next->args.size() > 1)
+         return false;
+
+      if(next->args.empty())
+      {
+         if(dst.a != IR::ArgBase::Nul && (dst.a != IR::ArgBase::Stk || dst.aStk.size))
+            return false;
+      }
+      else
+      {
+         if(dst.a != IR::ArgBase::Stk || next->args[0].a != IR::ArgBase::Stk ||
+            dst.aStk.size != next->args[0].aStk.size)
+            return false;
+      }
+
+      Core::FastU wb = Target::GetWordBytes();
+
+      // Arguments must exactly fill the parameters, so variadic calls are
+      // not transformed.
+      Core::FastU paramSize = 0;
+      for(std::size_t i = 2, e = stmnt->args.size(); i != e; ++i)
+      {
+         auto const &arg = stmnt->args[i];
+
+         if(arg.getSize() % wb)
+            return false;
+
+         paramSize += arg.getSize();
+      }
+
+      if(paramSize != func->param * wb)
+         return false;
+
+      for(auto const &st : func->block)
+         for(auto const &arg : st.args)
+            if(arg.a == IR::ArgBase::Vaa) return false;
+
+      // Returns the register word read by an argument, if any.
+      auto getArgWord = [&](IR::Arg const &arg, Core::FastU &argWord)
+      {
+         if(arg.a != IR::ArgBase::LocReg)
+            return false;
+
+         Core::FastU argIdx;
+         if(!getLocRegIdx(arg.aLocReg, argIdx) || argIdx % wb)
+            return false;
+
+         argWord = argIdx / wb;
+         return true;
+      };
+
+      // Parameters are assigned last to first, so an argument must not read
+      // a parameter assigned before it or partially overlap its own.
+      for(std::size_t i = stmnt->args.size(), word = func->param; i-- != 2;)
+      {
+         auto const &arg  = stmnt->args[i];
+         auto        size = arg.getSize() / wb;
+
+         word -= size;
+
+         if(arg.a == IR::ArgBase::Lit || arg.a == IR::ArgBase::Stk)
+            continue;
+
+         Core::FastU argWord;
+         if(!getArgWord(arg, argWord))
+            return false;
+
+         if(argWord != word && argWord + size > word && argWord < func->param)
+            return false;
+      }
+
+      // Find or add the entry label.
+      Core::String label = func->glyph + "$tail";
+      auto         head  = static_cast<IR::Statement *>(block->begin());
+
+      if(std::find(head->labs.begin(), head->labs.end(), label) == head->labs.end())
+         head->labs += Core::Array<Core::String>{label};
+
+      // Transform sequence.
+      block->setOrigin(stmnt->pos);
+      block->addLabel(std::move(stmnt->labs));
+
+      for(std::size_t i = stmnt->args.size(), word = func->param; i-- != 2;)
+      {
+         auto const &arg  = stmnt->args[i];
+         auto        size = arg.getSize();
+
+         word -= size / wb;
+
+         if(!size)
+            continue;
+
+         // The propagated auto pointer is left as-is, as the frame is reused.
+         if(i == 2 && Target::IsCallAutoProp(func->ctype))
+         {
+            if(arg.a == IR::ArgBase::Stk)
+               block->addStmnt(stmnt, IR::CodeBase::Move, IR::Arg_Nul(size), arg);
+
+            continue;
+         }
+
+         Core::FastU argWord;
+         if(getArgWord(arg, argWord) && argWord == word)
+            continue;
+
+         block->addStmnt(stmnt, IR::CodeBase::Move,
+            IR::Arg_LocReg(size, IR::Arg_Lit(wb, block->getExp(word * wb))), arg);
+      }
+
+      block->addStmnt(stmnt, IR::CodeBase::Jump,
+         IR::Arg_Lit(wb, block->getExp(IR::Glyph(prog, label))));
+
+      if(jfar)
+         delete jfar;
+
+      stmnt = stmnt->prev;
+      delete stmnt->next;
+
+      return true;
+   }
+
    //
    // Info::optStmnt_Cspe_Drop
    //
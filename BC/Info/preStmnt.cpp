@@ -0,0 +1,408 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Generic statement preparation.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Block.hpp"
+#include "IR/Exp.hpp"
+
+#include "Option/Bool.hpp"
+
+#include "Target/Info.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-opt-strength
+   //
+   static Option::Bool OptStrength
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-strength")
+         .setGroup("codegen")
+         .setDescS("Enables or disables constant strength reduction.")
+         .setDescL("Enables or disables constant strength reduction. When "
+            "enabled, division, modulo, and multiplication by constant "
+            "powers of two are rewritten as shifts and masks. Default on."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GetExpMask
+   //
+   // Returns a bits-wide literal with the low k bits set, or with all but the
+   // low k bits set if inv is true.
+   //
+   static IR::Exp::CRef GetExpMask(Core::FastU bits, Core::FastU k, bool inv,
+      Core::Origin pos)
+   {
+      Core::Integ val = (Core::Integ(1) << k) - 1;
+
+      if(inv)
+         val ^= (Core::Integ(1) << bits) - 1;
+
+      return IR::ExpCreate_Value(
+         IR::Value_Fixed(std::move(val), IR::Type_Fixed(bits, 0, false, false)), pos);
+   }
+
+   static bool IsRepeatArg(IR::Arg_Cpy const &) {return false;}
+   static bool IsRepeatArg(IR::Arg_Lit const &) {return true;}
+   static bool IsRepeatArg(IR::Arg_Nul const &) {return false;}
+   static bool IsRepeatArg(IR::Arg_Stk const &) {return false;}
+   static bool IsRepeatArg(IR::ArgPtr1 const &arg);
+   static bool IsRepeatArg(IR::ArgPtr2 const &arg);
+
+   //
+   // IsRepeatArg
+   //
+   // Checks if an argument can be read more than once with the same result.
+   //
+   static bool IsRepeatArg(IR::Arg const &arg)
+   {
+      switch(arg.a)
+      {
+         #define GDCC_Target_AddrList(name) \
+            case IR::ArgBase::name: return IsRepeatArg(arg.a##name);
+         #include "Target/AddrList.hpp"
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // IsRepeatArg
+   //
+   static bool IsRepeatArg(IR::ArgPtr1 const &arg)
+   {
+      return IsRepeatArg(*arg.idx);
+   }
+
+   //
+   // IsRepeatArg
+   //
+   static bool IsRepeatArg(IR::ArgPtr2 const &arg)
+   {
+      return IsRepeatArg(*arg.arr) && IsRepeatArg(*arg.idx);
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::getWordPow2
+   //
+   // Checks if a literal has exactly one of its low words*32 bits set and, if
+   // so, stores that bit's index in bit.
+   //
+   bool Info::getWordPow2(IR::Arg const &arg, Core::FastU words, Core::FastU &bit)
+   {
+      if(arg.a != IR::ArgBase::Lit || !arg.aLit.value->isValue())
+         return false;
+
+      bool found = false;
+
+      for(Core::FastU w = 0; w != words; ++w)
+      {
+         auto word = getWord(arg.aLit, w);
+
+         if(!word)
+            continue;
+
+         if(found || (word & (word - 1)))
+            return false;
+
+         found = true;
+         bit   = w * 32;
+         while(!(word & 1)) word >>= 1, ++bit;
+      }
+
+      return found;
+   }
+
+   //
+   // Info::preStmntConst
+   //
+   // Performs strength reduction of statements with constant operands. If
+   // the statement is rewritten, stmnt is left at the first statement that
+   // needs preparing.
+   //
+   bool Info::preStmntConst()
+   {
+      if(!OptStrength)
+         return false;
+
+      switch(stmnt->code.base)
+      {
+      case IR::CodeBase::Div: return preStmntConst_Div();
+      case IR::CodeBase::Mod: return preStmntConst_Mod();
+      case IR::CodeBase::Mul: return preStmntConst_Mul();
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // Info::preStmntConst_Div
+   //
+   bool Info::preStmntConst_Div()
+   {
+      auto size  = getStmntSize();
+      auto words = size / Target::GetWordBytes();
+      auto bits  = words * 32;
+
+      Core::FastU k;
+      if(!getWordPow2(stmnt->args[2], words, k))
+         return false;
+
+      auto getLit = [&](Core::FastU val)
+         {return IR::Arg_Lit(Target::GetWordBytes(), block->getExp(val));};
+
+      switch(stmnt->code.type[0])
+      {
+      case 'I':
+         // Single-word signed division is native, and cheaper than the
+         // rounding adjustment.
+         if(words < 2 || k == 0 || k >= bits - 1 || !IsRepeatArg(stmnt->args[1]))
+            return false;
+
+         {
+            // Negative dividends are biased by 2**k-1 to round toward zero.
+            //    ShR:I(Stk a B-1) ShR:U(Stk Stk B-k) Add:U(Stk Stk a)
+            //    ShR:I(dst Stk k)
+            auto prev = stmnt->prev;
+
+            block->setOrigin(stmnt->pos);
+            block->addLabel(std::move(stmnt->labs));
+            block->addStmnt(stmnt, IR::CodeBase::ShR+'I',
+               IR::Arg_Stk(size), stmnt->args[1], getLit(bits - 1));
+            block->addStmnt(stmnt, IR::CodeBase::ShR+'U',
+               IR::Arg_Stk(size), IR::Arg_Stk(size), getLit(bits - k));
+            block->addStmnt(stmnt, IR::CodeBase::Add+'U',
+               IR::Arg_Stk(size), IR::Arg_Stk(size), stmnt->args[1]);
+
+            stmnt->code    = IR::CodeBase::ShR+'I';
+            stmnt->args[1] = IR::Arg_Stk(size);
+            stmnt->args[2] = getLit(k);
+
+            stmnt = prev->next;
+         }
+         return true;
+
+      case 'K':
+      {
+         // Adjust for the fractional bits of the divisor.
+         auto bitsF = getFixedInfo(words, false).bitsF;
+
+         if(k < bitsF)
+         {
+            stmnt->code    = IR::CodeBase::ShL+'U';
+            stmnt->args[2] = getLit(bitsF - k);
+         }
+         else
+         {
+            stmnt->code    = IR::CodeBase::ShR+'U';
+            stmnt->args[2] = getLit(k - bitsF);
+         }
+      }
+         return true;
+
+      case 'U':
+         stmnt->code    = IR::CodeBase::ShR+'U';
+         stmnt->args[2] = getLit(k);
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // Info::preStmntConst_Mod
+   //
+   bool Info::preStmntConst_Mod()
+   {
+      auto size  = getStmntSize();
+      auto words = size / Target::GetWordBytes();
+      auto bits  = words * 32;
+
+      Core::FastU k;
+      if(!getWordPow2(stmnt->args[2], words, k))
+         return false;
+
+      switch(stmnt->code.type[0])
+      {
+      case 'I':
+         if(words < 2 || k == 0 || k >= bits - 1 || !IsRepeatArg(stmnt->args[1]))
+            return false;
+
+         {
+            // The remainder is the dividend less its rounded down multiple.
+            //    ShR:I(Stk a B-1) ShR:U(Stk Stk B-k) Add:U(Stk Stk a)
+            //    BAnd(Stk Stk ~(2**k-1)) Sub:U(Stk Stk a) Neg:I(dst Stk)
+            auto getLit = [&](Core::FastU val)
+               {return IR::Arg_Lit(Target::GetWordBytes(), block->getExp(val));};
+
+            auto prev = stmnt->prev;
+
+            block->setOrigin(stmnt->pos);
+            block->addLabel(std::move(stmnt->labs));
+            block->addStmnt(stmnt, IR::CodeBase::ShR+'I',
+               IR::Arg_Stk(size), stmnt->args[1], getLit(bits - 1));
+            block->addStmnt(stmnt, IR::CodeBase::ShR+'U',
+               IR::Arg_Stk(size), IR::Arg_Stk(size), getLit(bits - k));
+            block->addStmnt(stmnt, IR::CodeBase::Add+'U',
+               IR::Arg_Stk(size), IR::Arg_Stk(size), stmnt->args[1]);
+            block->addStmnt(stmnt, IR::CodeBase::BAnd,
+               IR::Arg_Stk(size), IR::Arg_Stk(size),
+               IR::Arg_Lit(size, GetExpMask(bits, k, true, stmnt->pos)));
+            block->addStmnt(stmnt, IR::CodeBase::Sub+'U',
+               IR::Arg_Stk(size), IR::Arg_Stk(size), stmnt->args[1]);
+
+            auto dst = std::move(stmnt->args[0]);
+            stmnt->code = IR::CodeBase::Neg+'I';
+            stmnt->args = {std::move(dst), IR::Arg_Stk(size)};
+
+            stmnt = prev->next;
+         }
+         return true;
+
+      case 'U':
+         stmnt->code    = IR::CodeBase::BAnd;
+         stmnt->args[2] = IR::Arg_Lit(size, GetExpMask(bits, k, false, stmnt->pos));
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // Info::preStmntConst_Mul
+   //
+   bool Info::preStmntConst_Mul()
+   {
+      auto size  = getStmntSize();
+      auto words = size / Target::GetWordBytes();
+
+      // Multiplication is commutative, so look for a literal on either side.
+      std::size_t litIdx = 2;
+      if(stmnt->args[2].a != IR::ArgBase::Lit)
+         litIdx = 1;
+
+      auto getLit = [&](Core::FastU val)
+         {return IR::Arg_Lit(Target::GetWordBytes(), block->getExp(val));};
+
+      Core::FastU bitsF;
+
+      switch(stmnt->code.type[0])
+      {
+      case 'I': case 'U': bitsF = 0; break;
+      case 'K': bitsF = getFixedInfo(words, false).bitsF; break;
+      case 'X': bitsF = getFixedInfo(words, true).bitsF; break;
+
+      default:
+         return false;
+      }
+
+      Core::FastU k;
+      if(getWordPow2(stmnt->args[litIdx], words, k))
+      {
+         // Right shifts would round differently than the multiplication.
+         if(k < bitsF)
+            return false;
+
+         // A signed fixed literal of just the sign bit is negative, which
+         // the shift drops once scaled by the fractional bits.
+         if(stmnt->code.type[0] == 'X' && k == words * 32 - 1)
+            return false;
+
+         if(litIdx == 1)
+            stmnt->args[1] = std::move(stmnt->args[2]);
+
+         stmnt->code    = IR::CodeBase::ShL+'U';
+         stmnt->args[2] = getLit(k - bitsF);
+         return true;
+      }
+
+      // Multi-word multiplication is a function call, so constants with two
+      // bits set are cheaper as a pair of shifts and an addition.
+      if(words < 2 || bitsF || stmnt->args[litIdx].a != IR::ArgBase::Lit ||
+         !stmnt->args[litIdx].aLit.value->isValue())
+         return false;
+
+      auto &src = stmnt->args[litIdx == 1 ? 2 : 1];
+      if(!IsRepeatArg(src))
+         return false;
+
+      // Find exactly two set bits.
+      Core::FastU kBit[2], kNum = 0;
+      for(Core::FastU w = 0; w != words; ++w)
+      {
+         auto word = getWord(stmnt->args[litIdx].aLit, w);
+
+         for(Core::FastU b = 0; word; ++b, word >>= 1)
+         {
+            if(!(word & 1))
+               continue;
+
+            if(kNum == 2)
+               return false;
+
+            kBit[kNum++] = w * 32 + b;
+         }
+      }
+
+      if(kNum != 2)
+         return false;
+
+      Core::FastU kLo = kBit[0], kHi = kBit[1];
+
+      auto prev = stmnt->prev;
+
+      block->setOrigin(stmnt->pos);
+      block->addLabel(std::move(stmnt->labs));
+      block->addStmnt(stmnt, IR::CodeBase::ShL+'U', IR::Arg_Stk(size), src, getLit(kHi));
+      block->addStmnt(stmnt, IR::CodeBase::ShL+'U', IR::Arg_Stk(size), src, getLit(kLo));
+
+      stmnt->code    = IR::CodeBase::Add+'U';
+      stmnt->args[1] = IR::Arg_Stk(size);
+      stmnt->args[2] = IR::Arg_Stk(size);
+
+      stmnt = prev->next;
+      return true;
+   }
+}
+
+// EOF
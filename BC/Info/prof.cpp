@@ -0,0 +1,292 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Profiling instrumentation.
+//
+// Each counter is one word of the static object ___GDCC__ProfCount, which
+// has ___GDCC__ProfSize words. libGDCC prints nonzero counters as lines of:
+//    GDCC::PROF <index> <count>
+//
+// The counters are described by a map file with a line per counter:
+//    <index> <func|block> <glyph> <origin>
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+
+#include "IR/Exp/Binary.hpp"
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Exp/Value.hpp"
+#include "IR/Function.hpp"
+#include "IR/Linkage.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/Bool.hpp"
+#include "Option/CStr.hpp"
+
+#include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
+#include <string>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-profile
+   //
+   static Option::Bool Profile
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-profile")
+         .setGroup("codegen")
+         .setDescS("Adds call counters to functions.")
+         .setDescL("Adds call counters to functions. Every defined function "
+            "and script counts its calls in a static array, which "
+            "__GDCC__prof_dump in libGDCC prints. A map of the counters is "
+            "written as set by --bc-profile-map, for use by gdcc-prof. "
+            "Default off.")
+   };
+
+   //
+   // --bc-profile-blocks
+   //
+   static Option::Bool ProfileBlocks
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-profile-blocks")
+         .setGroup("codegen")
+         .setDescS("Adds block counters to functions.")
+         .setDescL("Adds block counters to functions. With --bc-profile, "
+            "every labeled statement also counts how often it is reached. "
+            "Default off.")
+   };
+
+   //
+   // --bc-profile-map
+   //
+   static Option::CStr ProfileMap
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-profile-map")
+         .setGroup("output")
+         .setDescS("Sets the file to write the profile counter map to.")
+         .setDescL("Sets the file to write the profile counter map to. Use "
+            "- to write to stdout. Default is the output file with .prof "
+            "appended.")
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // ProfCounter
+   //
+   class ProfCounter
+   {
+   public:
+      Core::String glyph;
+      Core::Origin pos;
+      bool         block;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::BC
+{
+   static Core::String const ProfCount = "___GDCC__ProfCount";
+   static Core::String const ProfSize  = "___GDCC__ProfSize";
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // ProfAddCounter
+   //
+   // Adds an increment of counter idx before stmnt.
+   //
+   static void ProfAddCounter(IR::Program &prog, IR::Block &block,
+      IR::Statement *stmnt, Core::FastU idx, Core::Origin pos)
+   {
+      Core::FastU w = Target::GetWordBytes();
+
+      block.setOrigin(pos);
+
+      IR::Arg_Sta arg{w, IR::Arg_Lit(w, IR::ExpCreate_AddPtrRaw(
+         block.getExp(IR::Glyph(&prog, ProfCount)),
+         block.getExp(idx * w), pos))};
+
+      block.addStmnt(stmnt, IR::CodeBase::Add + 'U', arg, arg,
+         IR::Arg_Lit(w, block.getExp(Core::FastU(1))));
+   }
+
+   //
+   // ProfBackGlyph
+   //
+   // Backs a glyph referenced by libGDCC, if it is.
+   //
+   static void ProfBackGlyph(IR::Program &prog, Core::String glyph,
+      IR::Value const &val)
+   {
+      auto data = prog.findGlyphData(glyph);
+
+      if(!data || data->value)
+         return;
+
+      data->type  = val.getType();
+      data->value = IR::ExpCreate_Value(val, {nullptr, 0});
+   }
+
+   //
+   // ProfPutMap
+   //
+   static void ProfPutMap(std::vector<ProfCounter> const &counters)
+   {
+      std::string name;
+
+      if(ProfileMap.data())
+         name = ProfileMap.data();
+      else if(auto output = Core::GetOptionOutput())
+         name = std::string(output) + ".prof";
+      else
+         return;
+
+      auto buf = Core::FileOpenStream(name.data(), std::ios_base::out);
+
+      std::ostream out{buf.get()};
+
+      out << "GDCC::PROF 1\n";
+
+      for(std::size_t i = 0, e = counters.size(); i != e; ++i)
+      {
+         auto const &ctr = counters[i];
+         out << i << (ctr.block ? " block " : " func ") << ctr.glyph << ' '
+            << ctr.pos << '\n';
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::prof
+   //
+   void Info::prof()
+   {
+      // Already instrumented.
+      if(prog->findObject(ProfCount))
+         return;
+
+      std::vector<ProfCounter> counters;
+
+      if(Profile)
+      {
+         for(auto &fn : prog->rangeFunction())
+         {
+            if(!fn.defin || fn.block.empty() || fn.ctype == IR::CallType::AsmFunc)
+               continue;
+
+            auto pos    = fn.block.getOrigin();
+            auto origin = fn.getOrigin();
+
+            if(ProfileBlocks)
+            {
+               for(auto &itr : fn.block)
+               {
+                  if(itr.labs.empty())
+                     continue;
+
+                  fn.block.addLabel(std::move(itr.labs));
+                  itr.labs = Core::Array<Core::String>();
+
+                  ProfAddCounter(*prog, fn.block, &itr, counters.size(), itr.pos);
+                  counters.push_back({fn.glyph, itr.pos, true});
+               }
+            }
+
+            ProfAddCounter(*prog, fn.block, &*fn.block.begin(), counters.size(), origin);
+            counters.push_back({fn.glyph, origin, false});
+
+            fn.block.setOrigin(pos);
+         }
+
+         ProfPutMap(counters);
+      }
+
+      Core::FastU w    = Target::GetWordBytes();
+      Core::FastU size = counters.size();
+
+      if(size)
+      {
+         auto &countObj = prog->getObject(ProfCount);
+
+         countObj.linka = IR::Linkage::IntC;
+         countObj.space = {IR::AddrBase::Sta, Core::STR_};
+         countObj.words = size;
+
+         countObj.alloc = true;
+         countObj.defin = true;
+
+         prog->getGlyphData(ProfCount).type =
+            IR::Type_Point{IR::AddrBase::Sta, Core::STR_, size * w, 1};
+      }
+
+      ProfBackGlyph(*prog, ProfSize, IR::Value_Fixed(
+         Core::NumberCast<Core::Integ>(size),
+         IR::Type_Fixed(Target::GetWordBits(), 0, false, false)));
+
+      profBack();
+   }
+
+   //
+   // Info::profBack
+   //
+   void Info::profBack()
+   {
+      // Without counters, libGDCC gets a null pointer and a size of zero.
+      if(!prog->findObject(ProfCount))
+      {
+         ProfBackGlyph(*prog, ProfCount, IR::Value_Point(0,
+            IR::AddrBase::Sta, Core::STR_,
+            IR::Type_Point{IR::AddrBase::Sta, Core::STR_, 0, 1}));
+      }
+
+      ProfBackGlyph(*prog, ProfSize, IR::Value_Fixed(0,
+         IR::Type_Fixed(Target::GetWordBits(), 0, false, false)));
+   }
+}
+
+// EOF
+
@@ -0,0 +1,178 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Recorded profile data.
+//
+// Profile data is written by gdcc-prof --data, from the counters of a
+// program linked with --bc-profile. It is a text file holding:
+//    GDCC::PROFDATA 1
+//    <glyph> <count>
+// with a line for each function reached during the profiling run. The
+// count is the function's calls plus, if recorded, its block counts.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Profile.hpp"
+
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Number.hpp"
+#include "Core/Option.hpp"
+
+#include "Option/CStr.hpp"
+#include "Option/Int.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --profile-hot-percent
+   //
+   static Option::Int<Core::FastU> ProfileHotPercent
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("profile-hot-percent")
+         .setGroup("codegen")
+         .setDescS("Sets the share of recorded counts in hot functions.")
+         .setDescL("Sets the share of recorded counts in hot functions, as "
+            "a percentage. The functions with the highest counts in the "
+            "data from --profile-use are hot until together they account "
+            "for this share of all counts. Default is 90."),
+
+      90
+   };
+
+   //
+   // --profile-use
+   //
+   static Option::CStr ProfileUse
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("profile-use")
+         .setGroup("codegen")
+         .setDescS("Optimizes using recorded profile data.")
+         .setDescL("Optimizes using recorded profile data, as written by "
+            "gdcc-prof --data. Calls made by or to hot functions are "
+            "inlined with the budget set by --bc-inline-hot-stmnts, if "
+            "their arguments are no more costly to move than the call. "
+            "Other calls are not inlined. Block counts from "
+            "--bc-profile-blocks make functions with hot loops hot, not "
+            "just frequently called ones.")
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::BC
+{
+   static std::unordered_set<Core::String> ProfileHot;
+
+   static bool ProfileRead = false;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // ProfileReadData
+   //
+   static void ProfileReadData()
+   {
+      if(ProfileRead)
+         return;
+
+      ProfileRead = true;
+
+      auto buf = Core::FileOpenStream(ProfileUse.data(), std::ios_base::in);
+      std::istream in{buf.get()};
+
+      std::string line;
+      if(!std::getline(in, line) || line != "GDCC::PROFDATA 1")
+         Core::Error({}, "invalid profile data: ", ProfileUse.data());
+
+      std::vector<std::pair<Core::String, Core::FastU>> funcs;
+      Core::FastU total = 0;
+
+      while(std::getline(in, line))
+      {
+         std::istringstream lineIn{line};
+
+         std::string glyph;
+         Core::FastU count;
+         if(!(lineIn >> glyph >> count))
+            Core::Error({}, "invalid profile data: ", ProfileUse.data());
+
+         funcs.emplace_back(Core::String{glyph.data(), glyph.size()}, count);
+         total += count;
+      }
+
+      // The highest counts, up to the hot share of all counts.
+      std::sort(funcs.begin(), funcs.end(),
+         [](auto const &l, auto const &r) {return l.second > r.second;});
+
+      Core::FastU hot = total / 100 * ProfileHotPercent +
+         total % 100 * ProfileHotPercent / 100;
+
+      for(auto const &fn : funcs)
+      {
+         if(!hot || !fn.second) break;
+
+         ProfileHot.insert(fn.first);
+         hot -= std::min(hot, fn.second);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // ProfileIsHot
+   //
+   bool ProfileIsHot(Core::String glyph)
+   {
+      if(!ProfileIsUsed())
+         return false;
+
+      ProfileReadData();
+
+      return ProfileHot.count(glyph);
+   }
+
+   //
+   // ProfileIsUsed
+   //
+   bool ProfileIsUsed()
+   {
+      return ProfileUse.data();
+   }
+}
+
+// EOF
+
@@ -0,0 +1,33 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Recorded profile data.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__BC__Profile_H__
+#define GDCC__BC__Profile_H__
+
+#include "../BC/Types.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   // Checks if a function is among those taking most of the recorded calls.
+   bool ProfileIsHot(Core::String glyph);
+
+   // Checks if profile data is in use.
+   bool ProfileIsUsed();
+}
+
+#endif//GDCC__BC__Profile_H__
+
@@ -216,6 +216,26 @@ namespace GDCC::BC::ZDACS
       999
    };
 
+   //
+   // --bc-zdacs-init-tic-words
+   //
+   Option::Int<Core::FastU> Info::InitTicWords
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-init-tic-words")
+         .setGroup("codegen")
+         .setDescS("Sets the number of words to initialize per tic.")
+         .setDescL(
+            "Sets the maximum number of array words the init script "
+            "initializes before waiting for the next tic, so that large "
+            "initializers do not stall the first tic. Every script then "
+            "waits for initialization to finish before running. Ignored "
+            "with --bc-zdacs-init-script-event. Default is 0, which "
+            "disables waiting."),
+
+      0
+   };
+
    //
    // --bc-zdacs-script-flag
    //
@@ -384,17 +404,6 @@ namespace GDCC::BC::ZDACS
          Core::Origin(Core::STRNULL, 0));
    }
 
-   //
-   // Info::backGlyphObj
-   //
-   void Info::backGlyphObj(Core::String glyph, Core::FastU val)
-   {
-      auto &data = prog->getGlyphData(glyph);
-
-      data.value = IR::ExpCreate_Value(IR::Value_Point(val,
-         data.type.tPoint.reprB, data.type.tPoint.reprN, data.type.tPoint), {nullptr, 0});
-   }
-
    //
    // Info::backGlyphStrEnt
    //
@@ -597,6 +606,18 @@ namespace GDCC::BC::ZDACS
       return InitHubIndex;
    }
 
+   //
+   // Info::getInitTicWords
+   //
+   Core::FastU Info::getInitTicWords()
+   {
+      // An event init script runs before any script that could wait on it.
+      if(isInitScriptEvent())
+         return 0;
+
+      return InitTicWords;
+   }
+
    //
    // Info::getStkPtrIdx
    //
@@ -34,6 +34,7 @@
 #include "../../Target/CallType.hpp"
 
 #include <unordered_map>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -59,6 +60,7 @@ namespace GDCC::BC::ZDACS
       static Core::FastU FarJumpIndex;
 
       static Option::Bool             InitDelay;
+      static Option::Int<Core::FastU> InitTicWords;
       static Core::StringOption       InitScriptName;
       static Option::Bool             InitScriptNamed;
       static Option::Int<Core::FastU> InitScriptNumber;
@@ -95,15 +97,40 @@ namespace GDCC::BC::ZDACS
          InitTag     tag;
       };
 
+      //
+      // InitRun
+      //
+      // Initializes len consecutive words starting at idx, where word n is
+      // set to val + n * step. Only Fixed runs have more than one word.
+      //
+      class InitRun
+      {
+      public:
+         Core::FastU idx;
+         Core::FastU len;
+         Core::FastU val;
+         Core::FastU step;
+         InitTag     tag;
+      };
+
       //
       // InitData
       //
+      // Values are appended as generated, then sorted by word index with
+      // only the last value for each word kept. Unlisted words are Empty.
+      //
       class InitData
       {
       public:
          InitData() : max{0}, needTag{false}, onlyNil{true}, onlyStr{true} {}
 
-         std::unordered_map<Core::FastU, InitVal> vals;
+         InitVal &addVal(Core::FastU idx)
+            {return vals.emplace_back(idx, InitVal()).second;}
+
+         void sortVals();
+
+         std::vector<std::pair<Core::FastU, InitVal>> vals;
+         std::vector<InitRun>                         runs;
 
          Core::FastU max;
 
@@ -121,7 +148,6 @@ namespace GDCC::BC::ZDACS
       void backGlyphDJump(Core::String glyph, Core::FastU val);
       void backGlyphFunc(Core::String glyph, Core::FastU val, IR::CallType ctype);
       void backGlyphGlyph(Core::String glyph, Core::String val);
-      void backGlyphObj(Core::String glyph, Core::FastU val);
       void backGlyphStrEnt(Core::String glyph, Core::FastU val);
       void backGlyphWord(Core::String glyph, Core::FastU val);
 
@@ -163,7 +189,8 @@ namespace GDCC::BC::ZDACS
       virtual void genFunc();
 
       void genIniti();
-      void genInitiSpace(IR::Space &space);
+      void genInitiRuns(InitData &ini);
+      void genInitiSpace(IR::Space &space, Core::FastU &work);
 
       virtual void genObj();
 
@@ -316,6 +343,7 @@ namespace GDCC::BC::ZDACS
       Core::FastU getInitGblIndex();
       Core::FastU getInitHubArray();
       Core::FastU getInitHubIndex();
+      Core::FastU getInitTicWords();
 
       Core::FastU getSpaceInitiSize(IR::Type const &type);
 
@@ -508,7 +536,7 @@ namespace GDCC::BC::ZDACS
       void putHWord(Core::FastU i);
 
       void putIniti();
-      void putInitiSpace(IR::Space &space, Code code);
+      void putInitiSpace(IR::Space &space, Code code, Core::FastU &work);
 
       virtual void putStmnt();
       void putStmnt_Add();
@@ -21,6 +21,33 @@
 #include <sstream>
 
 
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   //
+   // GetInitiLoopSize
+   //
+   // Returns the code size of a loop initializing a run with step.
+   //
+   static Core::FastU GetInitiLoopSize(Core::FastU step)
+   {
+      // push_lit drop_reg
+      // push_reg <value> drop_arr incu_reg
+      // push_reg push_lit cmpu_ne jcnd_tru
+      Core::FastU size = 16 + 24 + 28;
+
+      // push_lit
+      if(!step) return size + 8;
+
+      // push_reg [push_lit mulu] push_lit addu
+      return size + (step == 1 ? 20 : 32);
+   }
+}
+
+
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
 //
@@ -76,6 +103,9 @@ namespace GDCC::BC::ZDACS
          numChunkCODE += 28;
       }
 
+      // Words initialized since the last wait.
+      Core::FastU work = 0;
+
       // Initialize world arrays.
       if(isHubArr)
       {
@@ -84,7 +114,7 @@ namespace GDCC::BC::ZDACS
          numChunkCODE += 24;
 
          // Count instructions needed for initializers.
-         for(auto &itr : prog->rangeSpaceHubArs()) genInitiSpace(itr);
+         for(auto &itr : prog->rangeSpaceHubArs()) genInitiSpace(itr, work);
       }
 
       // Initialize global arrays.
@@ -95,8 +125,8 @@ namespace GDCC::BC::ZDACS
          numChunkCODE += 24;
 
          // Count instructions needed for initializers.
-         for(auto &itr : prog->rangeSpaceGblArs()) genInitiSpace(itr);
-         genInitiSpace(prog->getSpaceSta());
+         for(auto &itr : prog->rangeSpaceGblArs()) genInitiSpace(itr, work);
+         genInitiSpace(prog->getSpaceSta(), work);
       }
 
       // Delay before setting initialized flag(s).
@@ -128,25 +158,109 @@ namespace GDCC::BC::ZDACS
       numChunkCODE += 4;
    }
 
+   //
+   // Info::genInitiRuns
+   //
+   // Splits initializer values into runs, merging consecutive words that
+   // form an arithmetic progression when a loop is smaller than storing
+   // each word. Zero words are skipped.
+   //
+   void Info::genInitiRuns(InitData &ini)
+   {
+      Core::FastU lenMax = getInitTicWords();
+      if(!lenMax) lenMax = ~Core::FastU(0);
+
+      ini.runs.clear();
+
+      for(auto itr = ini.vals.begin(), end = ini.vals.end(); itr != end;)
+      {
+         auto const &val = itr->second;
+
+         if(val.tag == InitTag::Empty)
+         {
+            ++itr;
+            continue;
+         }
+
+         if(val.tag != InitTag::Fixed)
+         {
+            ini.runs.push_back({itr->first, 1, val.val, 0, val.tag});
+            ++itr;
+            continue;
+         }
+
+         // Find the longest progression starting here.
+         Core::FastU len = 1, step = 0;
+         for(auto next = itr + 1; next != end && len != lenMax; ++next, ++len)
+         {
+            auto const &last = next[-1];
+
+            if(next->second.tag != InitTag::Fixed || next->first != last.first + 1)
+               break;
+
+            auto diff = (next->second.val - last.second.val) & 0xFFFFFFFF;
+
+            if(len == 1)
+               step = diff;
+            else if(diff != step)
+               break;
+         }
+
+         if(len > 1 && !step && !val.val)
+         {
+            itr += len;
+         }
+         else if(len * 24 > GetInitiLoopSize(step))
+         {
+            ini.runs.push_back({itr->first, len, val.val, step, InitTag::Fixed});
+            itr += len;
+         }
+         else
+         {
+            if(val.val)
+               ini.runs.push_back({itr->first, 1, val.val, 0, InitTag::Fixed});
+            ++itr;
+         }
+      }
+   }
+
    //
    // Info::genInitiSpace
    //
-   void Info::genInitiSpace(IR::Space &space_)
+   void Info::genInitiSpace(IR::Space &space_, Core::FastU &work)
    {
-      auto const &ini = init[&space_];
+      auto &ini = init[&space_];
+
+      genInitiRuns(ini);
+
+      Core::FastU tic = getInitTicWords();
 
       // Count instructions needed for initializers.
-      for(auto const &val : ini.vals) switch(val.second.tag)
+      for(auto const &run : ini.runs)
       {
-      case InitTag::Empty: break;
+         // Wait for the next tic if this run would exceed the limit.
+         if(tic && work && work + run.len > tic)
+         {
+            // wait_lit
+            numChunkCODE += 8;
+            work = 0;
+         }
+
+         work += run.len;
 
-      case InitTag::Fixed:
-         if(val.second.val)
-            numChunkCODE += 24;
-         break;
+         if(run.len > 1)
+         {
+            numChunkCODE += GetInitiLoopSize(run.step);
+            continue;
+         }
 
-      case InitTag::Funct: numChunkCODE += 24; break;
-      case InitTag::StrEn: numChunkCODE += 28; break;
+         switch(run.tag)
+         {
+         case InitTag::Empty: break;
+         case InitTag::Fixed: numChunkCODE += 24; break;
+         case InitTag::Funct: numChunkCODE += 24; break;
+         case InitTag::StrEn: numChunkCODE += 28; break;
+         }
       }
    }
 }
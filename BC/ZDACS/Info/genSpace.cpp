@@ -83,6 +83,27 @@ namespace GDCC::BC::ZDACS
       }
    }
 
+   //
+   // Info::InitData::sortVals
+   //
+   void Info::InitData::sortVals()
+   {
+      std::stable_sort(vals.begin(), vals.end(),
+         [](auto const &l, auto const &r){return l.first < r.first;});
+
+      // Later values for the same word replace earlier ones.
+      std::size_t n = 0;
+      for(auto &val : vals)
+      {
+         if(n && vals[n - 1].first == val.first)
+            vals[n - 1] = val;
+         else
+            vals[n++] = val;
+      }
+
+      vals.resize(n);
+   }
+
    //
    // Info::genSpaceIniti
    //
@@ -112,6 +133,8 @@ namespace GDCC::BC::ZDACS
             ini.max = idx;
       }
 
+      ini.sortVals();
+
       if(space->space.base == IR::AddrBase::ModArr && space->defin)
       {
          for(auto const &i : ini.vals)
@@ -201,7 +224,7 @@ namespace GDCC::BC::ZDACS
          break;
 
       case IR::ValueBase::DJump:
-         iv = &ini.vals[itr++];
+         iv = &ini.addVal(itr++);
          iv->tag = InitTag::Fixed;
          iv->val = val.vDJump.value;
          break;
@@ -213,7 +236,7 @@ namespace GDCC::BC::ZDACS
          bits = val.vFixed.vtype.bitsI + val.vFixed.vtype.bitsF + val.vFixed.vtype.bitsS;
          for(Core::FastU w = 0, e = (bits + 31) / 32; w != e; ++w)
          {
-            iv = &ini.vals[itr++];
+            iv = &ini.addVal(itr++);
             iv->tag = InitTag::Fixed;
             iv->val = getWord_Fixed(val.vFixed, w);
          }
@@ -223,14 +246,14 @@ namespace GDCC::BC::ZDACS
          bits = val.vFloat.vtype.bitsI + val.vFloat.vtype.bitsF + val.vFloat.vtype.bitsS;
          for(Core::FastU w = 0, e = (bits + 31) / 32; w != e; ++w)
          {
-            iv = &ini.vals[itr++];
+            iv = &ini.addVal(itr++);
             iv->tag = InitTag::Fixed;
             iv->val = getWord_Float(val.vFloat, w);
          }
          break;
 
       case IR::ValueBase::Funct:
-         iv = &ini.vals[itr++];
+         iv = &ini.addVal(itr++);
          if(!IsNull(val.vFunct))
          {
             if(IsScriptS(val.vFunct.vtype.callT))
@@ -244,13 +267,13 @@ namespace GDCC::BC::ZDACS
          break;
 
       case IR::ValueBase::Point:
-         iv = &ini.vals[itr++];
+         iv = &ini.addVal(itr++);
          iv->tag = InitTag::Fixed;
          iv->val = val.vPoint.value;
          break;
 
       case IR::ValueBase::StrEn:
-         iv = &ini.vals[itr++];
+         iv = &ini.addVal(itr++);
          if(IsNull(val.vStrEn))
             iv->tag = InitTag::Fixed;
          else
@@ -121,7 +121,7 @@ namespace GDCC::BC::ZDACS
    void Info::genStmnt_Xcod_SID()
    {
       if(!isInitScriptEvent())
-         numChunkCODE += 32;
+         numChunkCODE += getInitTicWords() ? 40 : 32;
    }
 
    //
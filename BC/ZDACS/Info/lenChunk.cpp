@@ -100,10 +100,9 @@ namespace GDCC::BC::ZDACS
 
       Core::FastU len = 0;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr &&
-            itr.first->defin && !itr.second.onlyNil)
-            len += itr.second.max * 4 + 12;
+      for(auto const &itr : prog->rangeSpaceModArs())
+         if(itr.defin && !init[&itr].onlyNil)
+            len += init[&itr].max * 4 + 12;
 
       return len;
    }
@@ -137,11 +136,12 @@ namespace GDCC::BC::ZDACS
 
       Core::FastU len = 0;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr && itr.first->defin)
+      for(auto const &itr : prog->rangeSpaceModArs())
       {
-         if(itr.second.needTag && !itr.second.onlyStr)
-            len += itr.second.max + 13;
+         auto const &ini = init[&itr];
+
+         if(itr.defin && ini.needTag && !ini.onlyStr)
+            len += ini.max + 13;
       }
 
       return len;
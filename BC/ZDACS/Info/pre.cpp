@@ -17,6 +17,8 @@
 
 #include "Target/CallType.hpp"
 
+#include <algorithm>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -42,6 +44,19 @@ namespace GDCC::BC::ZDACS
       if(func->defin && func->allocAut)
          preStmntCall("___GDCC__Plsa", 1, 1);
 
+      // Initialization spread over tics must finish before any script runs.
+      if(func->defin && getInitTicWords()) switch(func->ctype)
+      {
+      case IR::CallType::ScriptI:
+      case IR::CallType::ScriptS:
+         if(std::none_of(func->block.begin(), func->block.end(),
+            [](IR::Statement const &st) {return st.code == IR::CodeBase::Xcod_SID;}))
+            func->block.addStmnt(&*func->block.begin(), IR::CodeBase::Xcod_SID);
+         break;
+
+      default: break;
+      }
+
       InfoBase::preFunc();
    }
 
@@ -60,6 +75,9 @@ namespace GDCC::BC::ZDACS
    //
    void Info::preStmnt()
    {
+      if(preStmntConst())
+         throw ResetStmnt();
+
       switch(stmnt->code.base)
       {
       case IR::CodeBase::Add:   preStmnt_Add(); break;
@@ -108,7 +126,8 @@ namespace GDCC::BC::ZDACS
 
          prog->getGlyphData(name).type = IR::Type_Funct(newFn.ctype);
 
-         // Signal iterator to start over.
+         // Queue for the current pass and signal the caller to retry.
+         funcPend.push_back(&newFn);
          throw ResetFunc();
       }
    }
@@ -140,19 +140,22 @@ namespace GDCC::BC::ZDACS
    {
       if(!numChunkAINI) return;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr &&
-            itr.first->defin && !itr.second.onlyNil)
+      for(auto const &itr : prog->rangeSpaceModArs())
       {
+         auto const &ini = init[&itr];
+
+         if(!itr.defin || ini.onlyNil)
+            continue;
+
          putData("AINI", 4);
-         putWord(itr.second.max * 4 + 4);
-         putWord(itr.first->value);
+         putWord(ini.max * 4 + 4);
+         putWord(itr.value);
 
-         for(Core::FastU i = 0, e = itr.second.max; i != e; ++i)
+         auto val = ini.vals.begin(), valEnd = ini.vals.end();
+         for(Core::FastU i = 0, e = ini.max; i != e; ++i)
          {
-            auto val = itr.second.vals.find(i);
-            if(val != itr.second.vals.end())
-               putWord(val->second.val);
+            if(val != valEnd && val->first == i)
+               putWord((val++)->second.val);
             else
                putWord(0);
          }
@@ -188,11 +191,12 @@ namespace GDCC::BC::ZDACS
       putData("ASTR", 4);
       putWord(numChunkASTR * 4);
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr && itr.first->defin)
+      for(auto const &itr : prog->rangeSpaceModArs())
       {
-         if(itr.second.needTag && itr.second.onlyStr)
-            putWord(itr.first->value);
+         auto const &ini = init[&itr];
+
+         if(itr.defin && ini.needTag && ini.onlyStr)
+            putWord(itr.value);
       }
    }
 
@@ -203,21 +207,22 @@ namespace GDCC::BC::ZDACS
    {
       if(!numChunkATAG) return;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr && itr.first->defin)
+      for(auto const &itr : prog->rangeSpaceModArs())
       {
-         if(!itr.second.needTag || itr.second.onlyStr) continue;
+         auto const &ini = init[&itr];
+
+         if(!itr.defin || !ini.needTag || ini.onlyStr) continue;
 
          putData("ATAG", 4);
-         putWord(itr.second.max + 5);
+         putWord(ini.max + 5);
 
          putByte(0); // version
-         putWord(itr.first->value);
+         putWord(itr.value);
 
-         for(Core::FastU i = 0, e = itr.second.max; i != e; ++i)
+         auto val = ini.vals.begin(), valEnd = ini.vals.end();
+         for(Core::FastU i = 0, e = ini.max; i != e; ++i)
          {
-            auto val = itr.second.vals.find(i);
-            if(val != itr.second.vals.end()) switch(val->second.tag)
+            if(val != valEnd && val->first == i) switch((val++)->second.tag)
             {
             case InitTag::Empty: putByte(0); break;
             case InitTag::Fixed: putByte(0); break;
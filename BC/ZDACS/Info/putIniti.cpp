@@ -43,6 +43,9 @@ namespace GDCC::BC::ZDACS
          putCode(Code::Rscr);
       }
 
+      // Words initialized since the last wait.
+      Core::FastU work = 0;
+
       if(isHubArr)
       {
          // Check if already initialized.
@@ -55,7 +58,7 @@ namespace GDCC::BC::ZDACS
 
          // Write instructions needed for initializers.
          for(auto &itr : prog->rangeSpaceHubArs())
-            putInitiSpace(itr, Code::Drop_HubArr);
+            putInitiSpace(itr, Code::Drop_HubArr, work);
       }
 
       if(isGblArr)
@@ -70,8 +73,8 @@ namespace GDCC::BC::ZDACS
 
          // Write instructions needed for initializers.
          for(auto &itr : prog->rangeSpaceGblArs())
-            putInitiSpace(itr, Code::Drop_GblArr);
-         putInitiSpace(prog->getSpaceSta(), Code::Drop_GblArr);
+            putInitiSpace(itr, Code::Drop_GblArr, work);
+         putInitiSpace(prog->getSpaceSta(), Code::Drop_GblArr, work);
       }
 
       // Set initialized flag(s) after a delay to allow other
@@ -109,42 +112,92 @@ namespace GDCC::BC::ZDACS
    //
    // Info::putInitiSpace
    //
-   void Info::putInitiSpace(IR::Space &space_, Code code)
+   void Info::putInitiSpace(IR::Space &space_, Code code, Core::FastU &work)
    {
       auto const &ini = init[&space_];
 
-      // Write instructions needed for initializers.
-      for(auto const &val : ini.vals) switch(val.second.tag)
-      {
-      case InitTag::Empty: break;
-
-      case InitTag::Fixed:
-         // Skip zeroes.
-         if(!val.second.val) break;
+      // The event script's parameter is in the first local.
+      Core::FastU reg = isInitScriptEvent() ? 1 : 0;
 
-         putCode(Code::Push_Lit);
-         putWord(val.first);
-         putCode(Code::Push_Lit);
-         putWord(val.second.val);
-         putCode(code);
-         putWord(space_.value);
-         break;
+      Core::FastU tic = getInitTicWords();
 
-      case InitTag::Funct:
-         putCode(Code::Push_Lit);
-         putWord(val.first);
-         putStmntPushFunct(val.second.val);
-         putCode(code);
-         putWord(space_.value);
-         break;
-
-      case InitTag::StrEn:
-         putCode(Code::Push_Lit);
-         putWord(val.first);
-         putStmntPushStrEn(val.second.val);
-         putCode(code);
-         putWord(space_.value);
-         break;
+      // Write instructions needed for initializers.
+      for(auto const &run : ini.runs)
+      {
+         // Wait for the next tic if this run would exceed the limit.
+         if(tic && work && work + run.len > tic)
+         {
+            putCode(Code::Wait_Lit, 1);
+            work = 0;
+         }
+
+         work += run.len;
+
+         if(run.len > 1)
+         {
+            // for(reg = idx; reg != idx + len; ++reg) arr[reg] = <value>;
+            putCode(Code::Push_Lit, run.idx);
+            putCode(Code::Drop_LocReg, reg);
+
+            auto loop = putPos;
+
+            putCode(Code::Push_LocReg, reg);
+
+            if(run.step)
+            {
+               // val + (reg - idx) * step
+               putCode(Code::Push_LocReg, reg);
+               if(run.step != 1)
+               {
+                  putCode(Code::Push_Lit, run.step);
+                  putCode(Code::MulU);
+               }
+               putCode(Code::Push_Lit, (run.val - run.idx * run.step) & 0xFFFFFFFF);
+               putCode(Code::AddU);
+            }
+            else
+               putCode(Code::Push_Lit, run.val);
+
+            putCode(code, space_.value);
+            putCode(Code::IncU_LocReg, reg);
+
+            putCode(Code::Push_LocReg, reg);
+            putCode(Code::Push_Lit, (run.idx + run.len) & 0xFFFFFFFF);
+            putCode(Code::CmpU_NE);
+            putCode(Code::Jcnd_Tru, loop);
+
+            continue;
+         }
+
+         switch(run.tag)
+         {
+         case InitTag::Empty: break;
+
+         case InitTag::Fixed:
+            putCode(Code::Push_Lit);
+            putWord(run.idx);
+            putCode(Code::Push_Lit);
+            putWord(run.val);
+            putCode(code);
+            putWord(space_.value);
+            break;
+
+         case InitTag::Funct:
+            putCode(Code::Push_Lit);
+            putWord(run.idx);
+            putStmntPushFunct(run.val);
+            putCode(code);
+            putWord(space_.value);
+            break;
+
+         case InitTag::StrEn:
+            putCode(Code::Push_Lit);
+            putWord(run.idx);
+            putStmntPushStrEn(run.val);
+            putCode(code);
+            putWord(space_.value);
+            break;
+         }
       }
    }
 }
@@ -117,6 +117,10 @@ namespace GDCC::BC::ZDACS
       if(isInitScriptEvent())
          return;
 
+      // Initialization spread over tics needs to be waited on until done.
+      bool        loop = getInitTicWords();
+      Core::FastU head = putPos;
+
       if(isInitiHubArr())
       {
          arr  = getInitHubArray();
@@ -132,8 +136,8 @@ namespace GDCC::BC::ZDACS
       else
       {
          putCode(Code::Jump_Lit);
-         putWord(putPos + 28);
-         for(int i = 6; i--;) putCode(Code::Nop);
+         putWord(putPos + (loop ? 36 : 28));
+         for(int i = loop ? 8 : 6; i--;) putCode(Code::Nop);
          return;
       }
 
@@ -142,9 +146,12 @@ namespace GDCC::BC::ZDACS
       putCode(code);
       putWord(arr);
       putCode(Code::Jcnd_Tru);
-      putWord(putPos + 12);
+      putWord(putPos + (loop ? 20 : 12));
       putCode(Code::Wait_Lit);
       putWord(1);
+
+      if(loop)
+         putCode(Code::Jump_Lit, head);
    }
 
    //
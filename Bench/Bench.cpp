@@ -0,0 +1,290 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Benchmark registration and timing.
+//
+//-----------------------------------------------------------------------------
+
+#include "Bench/Bench.hpp"
+
+#include "Bench/Corpus.hpp"
+
+#include "Core/Dir.hpp"
+#include "Core/Option.hpp"
+#include "Core/Path.hpp"
+
+#include "Option/CStr.hpp"
+#include "Option/Int.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // --corpus
+   //
+   static Option::CStr CorpusDir
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("corpus")
+         .setGroup("input")
+         .setDescS("Sets the directory for generated sources.")
+         .setDescL("Sets the directory for generated sources. The directory "
+            "is created if needed and its corpus files are overwritten. "
+            "Default is gdcc-bench-corpus."),
+
+      "gdcc-bench-corpus", false
+   };
+
+   //
+   // --corpus-depth
+   //
+   static Option::Int<std::size_t> CorpusDepth
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("corpus-depth")
+         .setGroup("input")
+         .setDescS("Sets the depth of nested headers in generated sources.")
+         .setDescL("Sets the depth of nested headers in generated sources. "
+            "Default is 32."),
+
+      32
+   };
+
+   //
+   // --corpus-funcs
+   //
+   static Option::Int<std::size_t> CorpusFuncs
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("corpus-funcs")
+         .setGroup("input")
+         .setDescS("Sets the number of functions in generated sources.")
+         .setDescL("Sets the number of functions in generated sources. "
+            "Default is 2000."),
+
+      2000
+   };
+
+   //
+   // --min-time
+   //
+   static Option::Int<std::size_t> MinTime
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("min-time")
+         .setGroup("output")
+         .setDescS("Sets the minimum time to run each benchmark.")
+         .setDescL("Sets the minimum time to run each benchmark, in "
+            "milliseconds. The iteration count is increased until a run takes "
+            "at least this long. Default is 500."),
+
+      500
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // Result
+   //
+   class Result
+   {
+   public:
+      char const *name;
+      char const *skip;
+      std::size_t iterations;
+      std::size_t items;
+      std::size_t bytes;
+      double      seconds;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Bench
+{
+   Benchmark *Benchmark::Head = nullptr;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // IsSelected
+   //
+   static bool IsSelected(char const *name)
+   {
+      auto &args = Core::GetOptionArgs();
+
+      if(!args.size())
+         return true;
+
+      for(auto arg : args)
+      {
+         if(!std::strcmp(arg, name) || !std::strcmp(arg, "all"))
+            return true;
+      }
+
+      return false;
+   }
+
+   //
+   // PutResult
+   //
+   static void PutResult(std::ostream &out, Result const &res)
+   {
+      out << "    {\"name\": \"" << res.name << '"';
+
+      if(res.skip)
+      {
+         out << ", \"skipped\": \"" << res.skip << "\"}";
+         return;
+      }
+
+      out << ", \"iterations\": " << res.iterations
+         << ", \"seconds\": " << res.seconds
+         << ", \"ns-per-iter\": " << res.seconds * 1e9 / res.iterations;
+
+      if(res.items)
+         out << ", \"items-per-sec\": " << res.items / res.seconds;
+
+      if(res.bytes)
+         out << ", \"bytes-per-sec\": " << res.bytes / res.seconds;
+
+      out << '}';
+   }
+
+   //
+   // Run
+   //
+   // Runs a benchmark with increasing iteration counts until it takes at
+   // least the minimum time.
+   //
+   static Result Run(Benchmark const &bench)
+   {
+      using Clock = State::Clock;
+
+      auto const minTime = std::chrono::milliseconds(MinTime.data());
+
+      for(std::size_t iterations = 1;;)
+      {
+         State state{iterations};
+         bench.fn(state);
+         auto time = Clock::now() - state.begin;
+
+         if(state.skip)
+            return {bench.name, state.skip, 0, 0, 0, 0};
+
+         if(time >= minTime || iterations >= (std::size_t(1) << 30))
+         {
+            return {bench.name, nullptr, iterations, state.items, state.bytes,
+               std::chrono::duration<double>(time).count()};
+         }
+
+         // Estimate iterations needed from this run, with some margin.
+         auto timeNS = std::max<std::size_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(), 1);
+         auto goal = static_cast<std::size_t>(
+            std::chrono::nanoseconds(minTime).count() * 1.2 / timeNS * iterations);
+
+         iterations = std::clamp(goal, iterations * 2, iterations * 100);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // Benchmark constructor
+   //
+   Benchmark::Benchmark(char const *name_, Function fn_) :
+      name{name_}, fn{fn_}, next{Head}
+   {
+      Head = this;
+   }
+
+   //
+   // GetCorpusFile
+   //
+   std::string GetCorpusFile(char const *name)
+   {
+      static bool generated = false;
+
+      if(!generated)
+      {
+         Core::DirCreate(CorpusDir.data());
+         GenCorpusACS(CorpusDir.data(), CorpusFuncs, CorpusDepth);
+         GenCorpusC(CorpusDir.data(), CorpusFuncs, CorpusDepth);
+         generated = true;
+      }
+
+      std::string path{CorpusDir.data()};
+      Core::PathAppend(path, name);
+      return path;
+   }
+
+   //
+   // RunBenchmarks
+   //
+   void RunBenchmarks(std::ostream &out)
+   {
+      std::vector<Benchmark const *> benches;
+      for(auto bench = Benchmark::Head; bench; bench = bench->next)
+      {
+         if(IsSelected(bench->name))
+            benches.push_back(bench);
+      }
+
+      std::sort(benches.begin(), benches.end(),
+         [](Benchmark const *l, Benchmark const *r)
+            {return std::strcmp(l->name, r->name) < 0;});
+
+      out << "{\n  \"benchmarks\": [" << std::setprecision(9);
+
+      bool first = true;
+      for(auto bench : benches)
+      {
+         out << (first ? "\n" : ",\n");
+         PutResult(out, Run(*bench));
+         out.flush();
+
+         first = false;
+      }
+
+      out << "\n  ]\n}\n";
+   }
+}
+
+// EOF
+
@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Benchmark registration and timing.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Bench__Bench_H__
+#define GDCC__Bench__Bench_H__
+
+#include "../Bench/Types.hpp"
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // State
+   //
+   // Passed to a benchmark function, which must run its measured work
+   // iterations times. Setup done before calling start is not measured.
+   // Items and bytes are totals for all iterations, used for throughput.
+   //
+   class State
+   {
+   public:
+      using Clock = std::chrono::steady_clock;
+
+      explicit State(std::size_t iterations_) :
+         iterations{iterations_}, items{0}, bytes{0}, skip{nullptr},
+         begin{Clock::now()} {}
+
+      void start() {begin = Clock::now();}
+
+      std::size_t const iterations;
+      std::size_t       items;
+      std::size_t       bytes;
+
+      // If set by the benchmark, the reason it could not run.
+      char const *skip;
+
+      Clock::time_point begin;
+   };
+
+   //
+   // Benchmark
+   //
+   // Benchmarks are registered by defining a static Benchmark object.
+   //
+   class Benchmark
+   {
+   public:
+      using Function = void (*)(State &state);
+
+      Benchmark(char const *name, Function fn);
+
+      char const *const name;
+      Function    const fn;
+
+      Benchmark *next;
+
+
+      static Benchmark *Head;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Bench
+{
+   // Returns the path of a file in the corpus, generating it if needed.
+   std::string GetCorpusFile(char const *name);
+
+   // Runs benchmarks named by loose arguments, or all of them for "all" or
+   // no loose arguments, and writes JSON results to out.
+   void RunBenchmarks(std::ostream &out);
+}
+
+#endif//GDCC__Bench__Bench_H__
+
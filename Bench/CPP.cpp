@@ -0,0 +1,91 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Preprocessor benchmarks.
+//
+//-----------------------------------------------------------------------------
+
+#include "Bench/Bench.hpp"
+
+#include "Bench/Corpus.hpp"
+
+#include "CPP/IStream.hpp"
+#include "CPP/Macro.hpp"
+#include "CPP/TSource.hpp"
+#include "CPP/TStream.hpp"
+
+#include "Core/File.hpp"
+#include "Core/StringBuf.hpp"
+
+#include <sstream>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // cpp-istream
+   //
+   // Reads the C corpus one character at a time through the translation
+   // phase buffers.
+   //
+   static Benchmark CPPIStream{"cpp-istream", [](State &state)
+   {
+      auto buf = Core::FileOpenBlock(GetCorpusFile("main.c").data());
+
+      state.start();
+
+      for(auto n = state.iterations; n--;)
+      {
+         Core::StringBuf sbuf{buf->data(), buf->size()};
+         CPP::IStream    istr{sbuf, "main.c"};
+
+         while(istr.get() != EOF) {}
+
+         state.bytes += buf->size();
+      }
+   }};
+
+   //
+   // cpp-macro
+   //
+   // Preprocesses a source dominated by nested function-like macros.
+   //
+   static Benchmark CPPMacro{"cpp-macro", [](State &state)
+   {
+      std::ostringstream gen;
+      GenCorpusMacro(gen, 1000);
+      auto src = gen.str();
+
+      state.start();
+
+      for(auto n = state.iterations; n--;)
+      {
+         Core::String      file {"macro.c"};
+         CPP::IncludeLang  langs{"C"};
+         CPP::MacroMap     macr {CPP::Macro::Stringize(file)};
+         CPP::PragmaData   pragd{};
+         CPP::PragmaParser pragp{pragd};
+         Core::StringBuf   sbuf {src.data(), src.size()};
+         CPP::IStream      istr {sbuf, file};
+         CPP::TSource      tsrc {istr, istr.getOriginSource()};
+         CPP::PPStream     in   {tsrc, langs, macr, pragd, pragp, ""};
+
+         for(Core::Token tok; in >> tok;)
+            ++state.items;
+
+         state.bytes += src.size();
+      }
+   }};
+}
+
+// EOF
+
@@ -0,0 +1,81 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Core benchmarks.
+//
+//-----------------------------------------------------------------------------
+
+#include "Bench/Bench.hpp"
+
+#include "Core/Number.hpp"
+#include "Core/NumberAlloc.hpp"
+#include "Core/String.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // core-number-alloc
+   //
+   // Allocates and merges ranges the way string and object allocation do.
+   //
+   static Benchmark CoreNumberAlloc{"core-number-alloc", [](State &state)
+   {
+      for(auto n = state.iterations; n--;)
+      {
+         Core::NumberAllocMerge<Core::FastU> alloc;
+
+         for(Core::FastU i = 0; i != 1024; ++i)
+            alloc.alloc(1 + i % 7, (i * 37) % 512);
+
+         state.items += 1024;
+      }
+   }};
+
+   //
+   // core-string-intern
+   //
+   // Looks up identifiers, about a quarter of which are new to the table on
+   // the first iteration and all of which are present on later iterations.
+   //
+   static Benchmark CoreStringIntern{"core-string-intern", [](State &state)
+   {
+      std::vector<std::string> names;
+      std::size_t              bytes = 0;
+
+      for(std::size_t i = 0; i != 4096; ++i)
+      {
+         char buf[32];
+         std::sprintf(buf, i % 4 ? "name_%zu" : "__bench_%zu_x", i);
+         names.emplace_back(buf);
+         bytes += names.back().size();
+      }
+
+      state.start();
+
+      for(auto n = state.iterations; n--;)
+      {
+         for(auto const &name : names)
+            Core::String{name.data(), name.size()};
+      }
+
+      state.items = state.iterations * names.size();
+      state.bytes = state.iterations * bytes;
+   }};
+}
+
+// EOF
+
@@ -0,0 +1,211 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Synthetic source corpus generation.
+//
+// The generated programs are not meant to do anything useful, only to
+// exercise the compiler in proportion to real code: many small functions
+// with loops, branches, and calls, large constant initializers, and a long
+// chain of nested headers full of macros and declarations.
+//
+//-----------------------------------------------------------------------------
+
+#include "Bench/Corpus.hpp"
+
+#include "Core/File.hpp"
+#include "Core/Path.hpp"
+
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Bench
+{
+   static constexpr std::size_t CorpusTableSize = 4096;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // OpenCorpusFile
+   //
+   static auto OpenCorpusFile(char const *dir, std::string const &name)
+   {
+      std::string path{dir};
+      Core::PathAppend(path, name.data());
+      return Core::FileOpenStream(path.data(), std::ios_base::out);
+   }
+
+   //
+   // PutTable
+   //
+   // Writes the elements of a large initializer, using a simple LCG so the
+   // values are not trivially compressible.
+   //
+   static void PutTable(std::ostream &out)
+   {
+      std::uint_fast32_t x = 12345;
+
+      for(std::size_t i = 0; i != CorpusTableSize; ++i)
+      {
+         x = (x * 1103515245 + 12345) & 0x7FFFFFFF;
+         out << (i % 16 ? " " : "\n   ") << (x >> 16) << ',';
+      }
+
+      out << '\n';
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // GenCorpusACS
+   //
+   void GenCorpusACS(char const *dir, std::size_t funcs, std::size_t depth)
+   {
+      if(!depth) depth = 1;
+
+      for(std::size_t i = 0; i != depth; ++i)
+      {
+         auto buf = OpenCorpusFile(dir, "h" + std::to_string(i) + ".acs");
+         std::ostream out{buf.get()};
+
+         if(i + 1 != depth)
+            out << "#include \"h" << i + 1 << ".acs\"\n\n";
+
+         out << "#define C" << i << ' ' << i + 1 << '\n'
+            << "#define M" << i << "(x) ((x) * C" << i << " + " << i << ")\n\n"
+            << "function int h" << i << "(int x) {return M" << i << "(x);}\n";
+      }
+
+      auto buf = OpenCorpusFile(dir, "main.acs");
+      std::ostream out{buf.get()};
+
+      out << "#library \"corpus\"\n#include \"h0.acs\"\n\n"
+         << "int Table[" << CorpusTableSize << "] =\n{";
+      PutTable(out);
+      out << "};\n";
+
+      for(std::size_t n = 0; n != funcs; ++n)
+      {
+         auto d = n % depth;
+
+         out << "\nfunction int f" << n << "(int x, int y)\n{\n"
+            << "   int r = M" << d << "(x) + h" << d << "(y);\n"
+            << "   for(int i = 0; i < y; i++)\n"
+            << "      r += Table[(i + " << n << ") % " << CorpusTableSize << "];\n";
+
+         if(n)
+            out << "   if(r > " << n << ") r -= y;\n"
+               << "   else r += f" << n - 1 << "(r, y - 1);\n";
+
+         out << "   switch(x & 3)\n   {\n"
+            << "   case 0: r <<= 1; break;\n"
+            << "   case 1: r >>= 1; break;\n"
+            << "   default: r ^= " << n << "; break;\n"
+            << "   }\n"
+            << "   return r;\n}\n";
+      }
+
+      out << "\nscript 1 OPEN\n{\n   f" << (funcs ? funcs - 1 : 0)
+         << "(1, 2);\n}\n";
+   }
+
+   //
+   // GenCorpusC
+   //
+   void GenCorpusC(char const *dir, std::size_t funcs, std::size_t depth)
+   {
+      if(!depth) depth = 1;
+
+      for(std::size_t i = 0; i != depth; ++i)
+      {
+         auto buf = OpenCorpusFile(dir, "h" + std::to_string(i) + ".h");
+         std::ostream out{buf.get()};
+
+         out << "#ifndef H" << i << "\n#define H" << i << "\n\n";
+
+         if(i + 1 != depth)
+            out << "#include \"h" << i + 1 << ".h\"\n\n";
+
+         out << "#define C" << i << ' ' << i + 1 << '\n'
+            << "#define M" << i << "(x) ((x) * C" << i << " + " << i << ")\n\n"
+            << "typedef struct S" << i << " {int a, b; unsigned c[4];} S" << i << ";\n\n"
+            << "static inline int h" << i << "(S" << i << " const *s)\n"
+            << "   {return M" << i << "(s->a) + s->b;}\n\n"
+            << "#endif\n";
+      }
+
+      auto buf = OpenCorpusFile(dir, "main.c");
+      std::ostream out{buf.get()};
+
+      out << "#include \"h0.h\"\n\n"
+         << "static int const Table[" << CorpusTableSize << "] =\n{";
+      PutTable(out);
+      out << "};\n";
+
+      for(std::size_t n = 0; n != funcs; ++n)
+      {
+         auto d = n % depth;
+
+         out << "\nint f" << n << "(int x, int y)\n{\n"
+            << "   S" << d << " s = {x, y, {1, 2, 3, 4}};\n"
+            << "   int r = M" << d << "(x) + h" << d << "(&s);\n"
+            << "   for(int i = 0; i < y; ++i)\n"
+            << "      r += Table[(i + " << n << ") & " << CorpusTableSize - 1 << "] ^ i;\n";
+
+         if(n)
+            out << "   if(r > " << n << ") r -= y;\n"
+               << "   else r += f" << n - 1 << "(r, y - 1);\n";
+
+         out << "   switch(x & 3)\n   {\n"
+            << "   case 0: r <<= 1; break;\n"
+            << "   case 1: r >>= 1; break;\n"
+            << "   default: r ^= " << n << "; break;\n"
+            << "   }\n"
+            << "   return r;\n}\n";
+      }
+   }
+
+   //
+   // GenCorpusMacro
+   //
+   void GenCorpusMacro(std::ostream &out, std::size_t lines)
+   {
+      out << "#define ID(x) x\n"
+         << "#define ADD(x, y) ((x) + (y))\n"
+         << "#define MUL(x, y) ((x) * (y))\n"
+         << "#define CAT(x, y) x ## y\n"
+         << "#define STR(x) #x\n"
+         << "#define EXP(x) ADD(MUL(x, x), ID(x))\n"
+         << "#define VA(...) ADD(__VA_ARGS__)\n\n";
+
+      for(std::size_t n = 0; n != lines; ++n)
+      {
+         out << "int CAT(v, " << n << ") = EXP(" << n << ") + VA(ID("
+            << n << "), MUL(2, 3)); char const *CAT(s, " << n
+            << ") = STR(EXP(" << n << "));\n";
+      }
+   }
+}
+
+// EOF
+
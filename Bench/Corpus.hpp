@@ -0,0 +1,39 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Synthetic source corpus generation.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Bench__Corpus_H__
+#define GDCC__Bench__Corpus_H__
+
+#include "../Bench/Types.hpp"
+
+#include <ostream>
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Bench
+{
+   // Writes main.acs and a chain of depth headers, h0.acs to hN.acs.
+   void GenCorpusACS(char const *dir, std::size_t funcs, std::size_t depth);
+
+   // Writes main.c and a chain of depth headers, h0.h to hN.h.
+   void GenCorpusC(char const *dir, std::size_t funcs, std::size_t depth);
+
+   // Writes a single C source that makes heavy use of function-like macros
+   // and includes nothing.
+   void GenCorpusMacro(std::ostream &out, std::size_t lines);
+}
+
+#endif//GDCC__Bench__Corpus_H__
+
@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// IR benchmarks.
+//
+//-----------------------------------------------------------------------------
+
+#include "Bench/Bench.hpp"
+
+#include "CC/Parse.hpp"
+
+#include "Core/StringBuf.hpp"
+
+#include "IR/IArchive.hpp"
+#include "IR/OArchive.hpp"
+#include "IR/Program.hpp"
+
+#include <sstream>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // ir-archive
+   //
+   // Writes the IR for the C corpus and reads it back.
+   //
+   static Benchmark IRArchive{"ir-archive", [](State &state)
+   {
+      IR::Program prog;
+      CC::ParseFile(GetCorpusFile("main.c").data(), prog);
+
+      state.start();
+
+      for(auto n = state.iterations; n--;)
+      {
+         std::ostringstream out;
+         {
+            IR::OArchive arc{out};
+            arc.putHead();
+            arc << prog;
+            arc.putTail();
+         }
+
+         auto str = out.str();
+         state.bytes += str.size();
+
+         Core::StringBuf sbuf{str.data(), str.size()};
+         std::istream    in{&sbuf};
+         IR::IArchive    arc{in};
+         IR::Program     progIn;
+         arc >> progIn;
+      }
+   }};
+}
+
+// EOF
+
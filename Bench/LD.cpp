@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Compile and link benchmarks.
+//
+//-----------------------------------------------------------------------------
+
+#include "Bench/Bench.hpp"
+
+#include "ACC/Parse.hpp"
+
+#include "BC/Info.hpp"
+
+#include "CC/Parse.hpp"
+
+#include "Core/Option.hpp"
+#include "Core/StringBuf.hpp"
+
+#include "IR/IArchive.hpp"
+#include "IR/OArchive.hpp"
+#include "IR/Program.hpp"
+
+#include "LD/Linker.hpp"
+
+#include "Option/CStr.hpp"
+
+#include "Target/Info.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // --makelib
+   //
+   static Option::CStr MakeLibPath
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("makelib")
+         .setGroup("input")
+         .setDescS("Sets the gdcc-makelib program for the makelib benchmark.")
+         .setDescL("Sets the gdcc-makelib program for the makelib benchmark, "
+            "which builds libGDCC and libc for ZDoom. If not set, the "
+            "benchmark is skipped.")
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // Quote
+   //
+   static std::string Quote(std::string const &str)
+   {
+      std::string out{'"'};
+
+      for(char c : str)
+      {
+         if(c == '"' || c == '\\') out += '\\';
+         out += c;
+      }
+
+      return out += '"';
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Bench
+{
+   //
+   // acc-compile
+   //
+   static Benchmark ACCCompile{"acc-compile", [](State &state)
+   {
+      auto file = GetCorpusFile("main.acs");
+
+      state.start();
+
+      for(auto n = state.iterations; n--;)
+      {
+         IR::Program prog;
+         ACC::ParseFile(file.data(), prog);
+      }
+   }};
+
+   //
+   // cc-compile
+   //
+   static Benchmark CCCompile{"cc-compile", [](State &state)
+   {
+      auto file = GetCorpusFile("main.c");
+
+      state.start();
+
+      for(auto n = state.iterations; n--;)
+      {
+         IR::Program prog;
+         CC::ParseFile(file.data(), prog);
+      }
+   }};
+
+   //
+   // makelib
+   //
+   static Benchmark MakeLib{"makelib", [](State &state)
+   {
+      if(!MakeLibPath.data())
+         return static_cast<void>(state.skip = "--makelib not set");
+
+      std::string cmd = Quote(MakeLibPath.data()) +
+         " --lib-path " + Quote(Core::GetOptionLibPath()) +
+         " --target-engine ZDoom libGDCC libc -o " + Quote(GetCorpusFile("lib.o"));
+
+      for(auto n = state.iterations; n--;)
+      {
+         if(std::system(cmd.data()))
+            return static_cast<void>(state.skip = "gdcc-makelib failed");
+      }
+   }};
+
+   //
+   // zdacs-link
+   //
+   // Links the C corpus's IR to ZDoom bytecode, starting from the IR file
+   // as gdcc-ld would.
+   //
+   static Benchmark ZDACSLink{"zdacs-link", [](State &state)
+   {
+      std::string ir;
+      {
+         IR::Program prog;
+         CC::ParseFile(GetCorpusFile("main.c").data(), prog);
+
+         std::ostringstream out;
+         IR::OArchive arc{out};
+         arc.putHead();
+         arc << prog;
+         arc.putTail();
+         ir = out.str();
+      }
+
+      auto info = LD::GetBytecodeInfo(Target::Engine::ZDoom, Target::Format::ACSE);
+      if(!info)
+         return static_cast<void>(state.skip = "ZDACS not enabled");
+
+      state.start();
+
+      for(auto n = state.iterations; n--;)
+      {
+         Core::StringBuf sbuf{ir.data(), ir.size()};
+         std::istream    in{&sbuf};
+         IR::IArchive    arc{in};
+         IR::Program     prog;
+         arc >> prog;
+
+         std::ostringstream out;
+         LD::PutBytecode(out, prog, info.get());
+         state.bytes += out.str().size();
+      }
+   }};
+}
+
+// EOF
+
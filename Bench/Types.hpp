@@ -0,0 +1,30 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Common typedefs and class forward declarations.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Bench__Types_H__
+#define GDCC__Bench__Types_H__
+
+#include "../IR/Types.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Bench
+{
+   class Benchmark;
+   class State;
+}
+
+#endif//GDCC__Bench__Types_H__
+
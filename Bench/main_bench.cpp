@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Program entry point.
+//
+//-----------------------------------------------------------------------------
+
+#include "Bench/Bench.hpp"
+
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+
+#include "Option/Bool.hpp"
+
+#include "Target/Info.hpp"
+
+#include <iostream>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+//
+// --gen-corpus
+//
+static GDCC::Option::Bool GenCorpus
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("gen-corpus")
+      .setGroup("output")
+      .setDescS("Writes the generated sources and exits.")
+      .setDescL("Writes the generated sources to the corpus directory "
+         "without running any benchmarks, so they can be compiled with the "
+         "other tools."),
+
+   false
+};
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+//
+// MakeBench
+//
+static void MakeBench()
+{
+   if(GenCorpus)
+      return static_cast<void>(GDCC::Bench::GetCorpusFile(""));
+
+   // The benchmarks measure ZDoom codegen unless told otherwise.
+   if(GDCC::Target::EngineCur == GDCC::Target::Engine::None)
+      GDCC::Target::EngineCur = GDCC::Target::Engine::ZDoom;
+
+   auto outName = GDCC::Core::GetOptionOutput();
+   if(!outName) outName = "-";
+
+   auto buf = GDCC::Core::FileOpenStream(outName, std::ios_base::out);
+   std::ostream out{buf.get()};
+   GDCC::Bench::RunBenchmarks(out);
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+//
+// main
+//
+int main(int argc, char *argv[])
+{
+   auto &opts = GDCC::Core::GetOptions();
+
+   opts.list.name     = "gdcc-bench";
+   opts.list.nameFull = "GDCC Benchmarks";
+
+   opts.list.usage = "[option]... [benchmark]...";
+
+   opts.list.descS =
+      "Runs compiler benchmarks and writes the results as JSON. Use all to "
+      "run every benchmark. Output defaults to stdout.";
+
+   opts.list.descL =
+      "Runs compiler benchmarks and writes the results as JSON. Use all to "
+      "run every benchmark. Output defaults to stdout.\n"
+      "\n"
+      "Benchmarks:\n"
+      "  acc-compile, cc-compile, core-number-alloc, core-string-intern, "
+      "cpp-istream, cpp-macro, ir-archive, makelib, zdacs-link";
+
+   opts.optLibPath.insert(&opts.list);
+
+   try
+   {
+      GDCC::Core::ProcessOptions(opts, argc, argv, false);
+      MakeBench();
+   }
+   catch(std::exception const &e)
+   {
+      std::cerr << "ERROR: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+   }
+   catch(int e)
+   {
+      return e;
+   }
+}
+
+// EOF
+
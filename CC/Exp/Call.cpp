@@ -20,6 +20,9 @@
 #include "CC/Warning.hpp"
 
 #include "Core/Exception.hpp"
+#include "Core/Option.hpp"
+
+#include "Option/Int.hpp"
 
 #include "SR/Function.hpp"
 #include "SR/Type.hpp"
@@ -28,12 +31,105 @@
 #include "Target/Info.hpp"
 
 
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::CC
+{
+   //
+   // --inline-mem-words
+   //
+   static Option::Int<Core::FastU> InlineMemWords
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("inline-mem-words")
+         .setGroup("codegen")
+         .setDescS("Sets the maximum size of inlined memory functions.")
+         .setDescL("Sets the maximum size, in words, of a memcpy, memmove, "
+            "or memset call with a constant size to be generated as direct "
+            "word moves instead of a function call. 0 disables inlining. "
+            "Default is 16."),
+
+      16
+   };
+}
+
+
 //----------------------------------------------------------------------------|
 // Static Functions                                                           |
 //
 
 namespace GDCC::CC
 {
+   //
+   // IsAlignWord
+   //
+   // Checks if an argument, before conversion, points to word-aligned data.
+   //
+   static bool IsAlignWord(SR::Exp const *arg)
+   {
+      auto type = arg->getType();
+
+      if(!type->isTypePointer() && !type->isTypeArray())
+         return false;
+
+      type = type->getBaseType();
+
+      if(type->isTypeVoid() || !type->isTypeComplete())
+         return false;
+
+      return type->getSizeAlign() >= Target::GetWordBytes();
+   }
+
+   //
+   // IsCallMem
+   //
+   // Checks for a memory function call that can be done with word moves.
+   // argsRaw are the arguments before conversion to the parameter types.
+   //
+   static bool IsCallMem(SR::Function const *fn,
+      Core::Array<SR::Exp::CRef> const &args,
+      Core::Array<SR::Exp::CRef> const &argsRaw,
+      Exp_CallMem::Kind &kind, Core::FastU &words)
+   {
+      if(!fn || !InlineMemWords || args.size() != 3)
+         return false;
+
+      switch(fn->name)
+      {
+      case Core::STR___builtin_memcpy:  case Core::STR_memcpy:  kind = Exp_CallMem::Kind::Cpy; break;
+      case Core::STR___builtin_memmove: case Core::STR_memmove: kind = Exp_CallMem::Kind::Mov; break;
+      case Core::STR___builtin_memset:  case Core::STR_memset:  kind = Exp_CallMem::Kind::Set; break;
+      default: return false;
+      }
+
+      if(!args[2]->isIRExp() || (kind == Exp_CallMem::Kind::Set && !args[1]->isIRExp()))
+         return false;
+
+      if(!args[0]->getType()->isTypePointer() ||
+         (kind != Exp_CallMem::Kind::Set && !args[1]->getType()->isTypePointer()))
+         return false;
+
+      auto wordBytes = Target::GetWordBytes();
+      auto size      = ExpToFastU(args[2]);
+
+      if(!size || size % wordBytes || (words = size / wordBytes) > InlineMemWords)
+         return false;
+
+      // Sub-word pointers might not be aligned.
+      if(wordBytes != 1)
+      {
+         if(!IsAlignWord(argsRaw[0]))
+            return false;
+
+         if(kind != Exp_CallMem::Kind::Set && !IsAlignWord(argsRaw[1]))
+            return false;
+      }
+
+      return true;
+   }
+
    //
    // IsCallLit
    //
@@ -212,6 +308,9 @@ namespace GDCC::CC
       if(args.size() > param->size() && !param->variadic())
          Core::Error(pos, "too many arguments");
 
+      // Keep unconverted args for checking memory function alignment.
+      Core::Array<SR::Exp::CRef> argsRaw = args;
+
       // Promote/convert args.
       auto paramItr = param->begin(), paramEnd = param->end();
       auto argsItr  = args.begin(),   argsEnd  = args.end();
@@ -226,7 +325,19 @@ namespace GDCC::CC
          return Exp_CallLit::Create(exp, pos, std::move(args));
 
       if(scopeLocal)
-         return Exp_CallStk::Create(exp, pos, std::move(args), *scopeLocal);
+      {
+         Exp_CallMem::Kind kind;
+         Core::FastU       words;
+         bool              mem = IsCallMem(fn, args, argsRaw, kind, words);
+
+         auto call = Exp_CallStk::Create(exp, pos, std::move(args), *scopeLocal);
+
+         // Check for memory functions that can be done inline.
+         if(mem)
+            return Exp_CallMem::Create(call, kind, words);
+
+         return call;
+      }
       else
          Core::Error(pos, "invalid scope for call");
    }
@@ -80,6 +80,47 @@ namespace GDCC::CC
       virtual void v_genStmnt(SR::GenStmntCtx const &ctx, SR::Arg const &dst) const;
    };
 
+   //
+   // Exp_CallMem
+   //
+   // Handles calls to memcpy, memmove, and memset with a constant size by
+   // moving whole words directly, falling back to the library call when
+   // the destination cannot be evaluated twice for the result.
+   //
+   class Exp_CallMem : public Exp_Call
+   {
+      GDCC_Core_CounterPreamble(GDCC::CC::Exp_CallMem, GDCC::CC::Exp_Call);
+
+   public:
+      //
+      // Kind
+      //
+      enum class Kind
+      {
+         Cpy,
+         Mov,
+         Set,
+      };
+
+      Exp_Call::CRef const call;
+      Core::FastU    const words;
+      Kind           const kind;
+
+
+      // Create
+      static CRef Create(Exp_Call const *call, Kind kind, Core::FastU words)
+         {return CRef(new This(call, kind, words));}
+
+   protected:
+      Exp_CallMem(Exp_Call const *call_, Kind kind_, Core::FastU words_) :
+         Super{call_->exp, call_->pos, call_->args}, call{call_},
+         words{words_}, kind{kind_} {}
+
+      virtual void v_genStmnt(SR::GenStmntCtx const &ctx, SR::Arg const &dst) const;
+
+      SR::Arg getArgMem(SR::Exp const *ptr) const;
+   };
+
    //
    // Exp_CallStk
    //
@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// C "operator ()" memory function expressions.
+//
+//-----------------------------------------------------------------------------
+
+#include "CC/Exp/Call.hpp"
+
+#include "CC/Exp.hpp"
+#include "CC/Type.hpp"
+
+#include "IR/Arg.hpp"
+#include "IR/Block.hpp"
+
+#include "SR/Arg.hpp"
+#include "SR/Type.hpp"
+
+#include "Target/Info.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CC
+{
+   //
+   // Exp_CallMem::getArgMem
+   //
+   // Returns an arg for the words pointed to by ptr.
+   //
+   SR::Arg Exp_CallMem::getArgMem(SR::Exp const *ptr) const
+   {
+      auto memType = TypeIntegPrU->getTypeArray(words)
+         ->getTypeQual(ptr->getType()->getBaseType()->getQual());
+
+      return SR::Arg(memType, ptr);
+   }
+
+   //
+   // Exp_CallMem::v_genStmnt
+   //
+   void Exp_CallMem::v_genStmnt(SR::GenStmntCtx const &ctx,
+      SR::Arg const &dst) const
+   {
+      bool result = dst.type->getQualAddr().base != IR::AddrBase::Nul;
+
+      // The result is the destination pointer, which is evaluated again.
+      if(result && args[0]->isEffect())
+         return call->genStmnt(ctx, dst);
+
+      switch(kind)
+      {
+      case Kind::Cpy:
+         SR::GenStmnt_Move(this, ctx, getArgMem(args[0]), getArgMem(args[1]));
+         break;
+
+      case Kind::Mov:
+         // Always go through the stack, in case of overlap.
+         SR::GenStmnt_MovePart(this, ctx, getArgMem(args[1]), true, false);
+         SR::GenStmnt_MovePart(this, ctx, getArgMem(args[0]), false, true);
+         break;
+
+      case Kind::Set:
+      {
+         // Replicate the byte across a whole word.
+         Core::FastU wordBytes = Target::GetWordBytes();
+         Core::FastU byteBits  = 32 / wordBytes;
+         Core::FastU byte      = ExpToFastU(args[1]) & ((Core::FastU(1) << byteBits) - 1);
+         Core::FastU word      = 0;
+
+         for(Core::FastU i = 0; i != wordBytes; ++i)
+            word = (word << byteBits) | byte;
+
+         IR::Arg_Lit lit{wordBytes, ctx.block.getExp(word)};
+         for(Core::FastU i = 0; i != words; ++i)
+            ctx.block.addStmnt(IR::CodeBase::Move, IR::Arg_Stk(wordBytes), lit);
+
+         SR::GenStmnt_MovePart(this, ctx, getArgMem(args[0]), false, true);
+      }
+         break;
+      }
+
+      if(result)
+         SR::GenStmnt_Move(this, ctx, dst, args[0]->getArgSrc());
+   }
+}
+
+// EOF
+
@@ -22,6 +22,7 @@
 
 #include "Core/File.hpp"
 #include "Core/Path.hpp"
+#include "Core/Stats.hpp"
 #include "Core/StringBuf.hpp"
 
 #include "IR/Program.hpp"
@@ -72,8 +73,12 @@ namespace GDCC::CC
       Scope_Global      scope{GetGlobalLabel(buf->getHash())};
 
       // Read declarations.
-      while(ctx.in.peek().tok != Core::TOK_EOF)
-         ctx.getDecl(scope);
+      {
+         Core::StatPhase phase{"parse"};
+
+         while(ctx.in.peek().tok != Core::TOK_EOF)
+            ctx.getDecl(scope);
+      }
 
       // Add ACS libraries.
       for(auto const &lib : pragd.stateLibrary)
@@ -82,6 +87,7 @@ namespace GDCC::CC
       scope.allocAuto();
 
       // Generate IR data.
+      Core::StatPhase phase{"genIR"};
       scope.genIR(prog);
    }
 }
@@ -17,9 +17,18 @@
 #include "CC/Scope/Case.hpp"
 
 #include "Core/Exception.hpp"
+#include "Core/Option.hpp"
 
 #include "IR/Block.hpp"
+#include "IR/DJump.hpp"
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Exp/Multi.hpp"
 #include "IR/Glyph.hpp"
+#include "IR/Linkage.hpp"
+#include "IR/Object.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/Int.hpp"
 
 #include "SR/Exp.hpp"
 #include "SR/Function.hpp"
@@ -28,6 +37,34 @@
 
 #include "Target/Info.hpp"
 
+#include <algorithm>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::CC
+{
+   //
+   // --switch-table-density
+   //
+   static Option::Int<Core::FastU> SwitchTableDensity
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("switch-table-density")
+         .setGroup("codegen")
+         .setDescS("Sets the minimum case density for switch jump tables.")
+         .setDescL("Sets the minimum case density, as a percentage of the "
+            "range of case values, for a switch statement to be considered "
+            "for a jump table. A value over 100 disables jump tables. "
+            "Values under 1 are treated as 1. Jump tables are never used "
+            "for ranges over 65536 values. Default is 50."),
+
+      50
+   };
+}
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
@@ -36,6 +73,16 @@
 namespace GDCC::CC
 {
    using CodePair = std::pair<IR::Code, IR::Code>;
+
+   //
+   // SwitchGen
+   //
+   enum class SwitchGen
+   {
+      Search,
+      Search_Jcnd_Tab,
+      Table,
+   };
 }
 
 
@@ -45,6 +92,85 @@ namespace GDCC::CC
 
 namespace GDCC::CC
 {
+   //
+   // GenCond_Cases
+   //
+   // Collects cases sorted by value, with null sentinels at each end.
+   //
+   static std::vector<Scope_Case::Case const *> GenCond_Cases(
+      Statement_Switch const *stmnt)
+   {
+      std::vector<Scope_Case::Case const *> cases;
+      cases.reserve(stmnt->scope.size() + 2);
+
+      cases.emplace_back(nullptr);
+      for(auto const &c : stmnt->scope)
+         cases.emplace_back(&c);
+      cases.emplace_back(nullptr);
+
+      std::sort(cases.begin() + 1, cases.end() - 1,
+         [](Scope_Case::Case const *l, Scope_Case::Case const *r)
+            {return l->value < r->value;});
+
+      return cases;
+   }
+
+   //
+   // GenCond_Choose
+   //
+   // Selects the dispatch with the lowest estimated count of executed VM
+   // instructions.
+   //
+   static SwitchGen GenCond_Choose(Statement_Switch const *stmnt)
+   {
+      Core::FastU count = stmnt->scope.size();
+      Core::FastU words = stmnt->cond->getType()->getSizeWords();
+
+      // Binary search depth.
+      Core::FastU depth = 0;
+      while(depth < 64 && (Core::FastU(1) << depth) <= count) ++depth;
+
+      // Each search level compares and branches.
+      Core::FastU costSearch = depth * 4 * words;
+      SwitchGen   gen        = SwitchGen::Search;
+      Core::FastU cost       = costSearch;
+
+      if(words != 1)
+         return gen;
+
+      // Sorted case jump is a single instruction searching natively.
+      if(Target::IsFamily_ZDACS())
+      {
+         Core::FastU costTab = 3 + (depth + 3) / 4;
+         if(costTab <= cost)
+            gen = SwitchGen::Search_Jcnd_Tab, cost = costTab;
+      }
+
+      // Jump table has a fixed cost, but needs a dense range to be small.
+      if(count > 1)
+      {
+         Core::Integ caseMin = (*stmnt->scope.begin()).value, caseMax = caseMin;
+         for(auto const &c : stmnt->scope)
+         {
+            if(caseMin > c.value) caseMin = c.value;
+            if(caseMax < c.value) caseMax = c.value;
+         }
+
+         // Every value in the range needs a table entry.
+         Core::FastU density = std::max<Core::FastU>(SwitchTableDensity, 1);
+
+         Core::Integ range   = caseMax - caseMin + 1;
+         Core::Integ caseArea = Core::NumberCast<Core::Integ>(count * 100);
+         Core::Integ tabArea  = range * Core::NumberCast<Core::Integ>(density);
+
+         Core::FastU costTable = Target::GetWordBytes() == 1 ? 12 : 14;
+         if(costTable < cost && caseArea >= tabArea && range <= 0x10000)
+            gen = SwitchGen::Table, cost = costTable;
+      }
+
+      return gen;
+   }
+
    //
    // GenCond_Codes
    //
@@ -157,17 +283,7 @@ namespace GDCC::CC
       SR::GenStmntCtx const &ctx, CodePair const &codes)
    {
       // Collect and sort cases.
-      std::vector<Scope_Case::Case const *> cases;
-      cases.reserve(stmnt->scope.size() + 2);
-
-      cases.emplace_back(nullptr);
-      for(auto const &c : stmnt->scope)
-         cases.emplace_back(&c);
-      cases.emplace_back(nullptr);
-
-      std::sort(cases.begin() + 1, cases.end() - 1,
-         [](Scope_Case::Case const *l, Scope_Case::Case const *r)
-            {return l->value < r->value;});
+      auto cases = GenCond_Cases(stmnt);
 
       // Evaluate condition and store in temporary.
       stmnt->cond->genStmntStk(ctx);
@@ -211,6 +327,92 @@ namespace GDCC::CC
          IR::Arg_Nul(caseSize), IR::Arg_Stk(caseSize));
       GenCond_BranchDefault(stmnt, ctx);
    }
+
+   //
+   // GenCond_Table
+   //
+   // Generates a bounds check and a dynamic jump through a static table of
+   // DJump values covering every value from the lowest case to the highest.
+   //
+   static void GenCond_Table(Statement_Switch const *stmnt,
+      SR::GenStmntCtx const &ctx)
+   {
+      Core::FastU wordBytes = Target::GetWordBytes();
+
+      auto cases = GenCond_Cases(stmnt);
+      auto begin = cases.begin() + 1, end = cases.end() - 1;
+
+      Core::Integ caseMin = (*begin)->value;
+      Core::FastU range   = Core::NumberCast<Core::FastU>(end[-1]->value - caseMin + 1);
+
+      // Generate table.
+      Core::String defLabel = stmnt->scope.getLabelDefault(false);
+      Core::String tabGlyph = ctx.fn->genLabel() + "$switch";
+
+      auto getDJump = [&](Core::String label)
+      {
+         auto &djump = ctx.prog.getDJump(label + "$djump");
+
+         djump.label = label;
+         djump.alloc = true;
+         djump.defin = true;
+
+         ctx.prog.getGlyphData(djump.glyph).type = IR::Type_DJump();
+
+         return IR::ExpCreate_Glyph({ctx.prog, djump.glyph}, stmnt->pos);
+      };
+
+      Core::Array<IR::Exp::CRef> tabElem{range, getDJump(defLabel)};
+      for(auto itr = begin; itr != end; ++itr)
+         tabElem[Core::NumberCast<Core::FastU>((*itr)->value - caseMin)] =
+            getDJump((*itr)->label);
+
+      auto &tabObj = ctx.prog.getObject(tabGlyph);
+
+      tabObj.initi = IR::ExpCreate_Array(IR::Type_DJump(), std::move(tabElem), stmnt->pos);
+      tabObj.linka = IR::Linkage::None;
+      tabObj.space = {IR::AddrBase::Sta, Core::STR_};
+      tabObj.words = range;
+      tabObj.alloc = true;
+      tabObj.defin = true;
+
+      ctx.prog.getGlyphData(tabGlyph).type =
+         IR::Type_Point(IR::AddrBase::Sta, Core::STR_, wordBytes, 1);
+
+      // Evaluate condition as an offset from the lowest case.
+      stmnt->cond->genStmntStk(ctx);
+
+      ctx.block.setArgSize(wordBytes);
+
+      if(caseMin != 0)
+         ctx.block.addStmnt(IR::CodeBase::Sub+'U', IR::Block::Stk(), IR::Block::Stk(),
+            GenCond_GenValue(stmnt, *begin));
+
+      SR::Temporary tmp{ctx, stmnt->pos, 1};
+      ctx.block.addStmnt(IR::CodeBase::Move, tmp.getArg(), tmp.getArgStk());
+
+      // Branch to default if out of range.
+      ctx.block.addStmnt(IR::CodeBase::CmpGT+'U', IR::Block::Stk(), tmp.getArg(),
+         range - 1);
+      ctx.block.addStmnt(IR::CodeBase::Jcnd_Tru, IR::Block::Stk(),
+         IR::Glyph(ctx.prog, defLabel));
+
+      // Load table entry and branch.
+      ctx.block.addStmnt(IR::CodeBase::Move, IR::Block::Stk(),
+         IR::Glyph(ctx.prog, tabGlyph));
+
+      if(wordBytes != 1)
+         ctx.block.addStmnt(IR::CodeBase::Mul+'U', IR::Block::Stk(), tmp.getArg(),
+            wordBytes);
+      else
+         ctx.block.addStmnt(IR::CodeBase::Move, IR::Block::Stk(), tmp.getArg());
+
+      ctx.block.addStmnt(IR::CodeBase::Add+'U',
+         IR::Block::Stk(), IR::Block::Stk(), IR::Block::Stk());
+      ctx.block.addStmnt(IR::CodeBase::Move,
+         IR::Block::Stk(), IR::Arg_Sta(wordBytes, IR::Arg_Stk(wordBytes)));
+      ctx.block.addStmnt(IR::CodeBase::Jdyn, IR::Block::Stk());
+   }
 }
 
 
@@ -243,10 +445,20 @@ namespace GDCC::CC
    void Statement_Switch::v_genStmnt(SR::GenStmntCtx const &ctx) const
    {
       // Generate condition.
-      if(Target::IsFamily_ZDACS() && cond->getType()->getSizeWords() == 1)
-         GenCond_Search_Jcnd_Tab(this, ctx);
-      else
+      switch(GenCond_Choose(this))
+      {
+      case SwitchGen::Search:
          GenCond_Search(this, ctx, GenCond_Codes(this, cond->getType()));
+         break;
+
+      case SwitchGen::Search_Jcnd_Tab:
+         GenCond_Search_Jcnd_Tab(this, ctx);
+         break;
+
+      case SwitchGen::Table:
+         GenCond_Table(this, ctx);
+         break;
+      }
 
       // Generate body.
       body->genStmnt(ctx);
@@ -32,6 +32,7 @@ namespace GDCC::CC
    class Exp_Assign;
    class Exp_Call;
    class Exp_CallLit;
+   class Exp_CallMem;
    class Exp_CallStk;
    class Exp_ConvertBoolSoft_Fixed;
    class Exp_ConvertBoolSoft_Float;
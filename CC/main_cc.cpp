@@ -12,12 +12,14 @@
 
 #include "CC/Parse.hpp"
 
+#include "CPP/Depend.hpp"
 #include "CPP/IncludeDTBuf.hpp"
 
 #include "Core/Option.hpp"
 
 #include "IR/Program.hpp"
 
+#include "LD/Cache.hpp"
 #include "LD/Linker.hpp"
 
 #include <iostream>
@@ -34,15 +36,35 @@ static void MakeC()
 {
    GDCC::IR::Program prog;
 
+   // Only scan for dependencies?
+   if(GDCC::CPP::IsDependOnly())
+   {
+      for(auto const &arg : GDCC::Core::GetOptionArgs())
+         GDCC::CPP::DependScan(arg);
+
+      for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
+         GDCC::CPP::DependScan(arg);
+
+      GDCC::CPP::DependPut(GDCC::Core::GetOptionOutput());
+      return;
+   }
+
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      GDCC::CC::ParseFile(arg, prog);
+   {
+      GDCC::LD::CacheParse(arg, prog, GDCC::CC::ParseFile);
+      GDCC::CPP::DependAdd(arg);
+   }
 
    for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
-      GDCC::CC::ParseFile(arg, prog);
+   {
+      GDCC::LD::CacheParse(arg, prog, GDCC::CC::ParseFile);
+      GDCC::CPP::DependAdd(arg);
+   }
 
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
+   GDCC::CPP::DependPut(GDCC::Core::GetOptionOutput());
 }
 
 
@@ -175,7 +175,7 @@ namespace GDCC::CPP
       {
          DirectiveTBuf::underflow();
          if(tptr() == tend() || tptr()->tok == Core::TOK_EOF || !isSkip()) break;
-         bumpt(1);
+         bumpt(tend() - tptr());
       }
    }
 
@@ -0,0 +1,323 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Make dependency output.
+//
+//-----------------------------------------------------------------------------
+
+#include "CPP/Depend.hpp"
+
+#include "CPP/IStream.hpp"
+#include "CPP/Macro.hpp"
+#include "CPP/Pragma.hpp"
+#include "CPP/TSource.hpp"
+#include "CPP/TStream.hpp"
+
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+#include "Core/Path.hpp"
+#include "Core/Stats.hpp"
+#include "Core/StringBuf.hpp"
+
+#include "Option/Exception.hpp"
+#include "Option/Function.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // DependRule
+   //
+   class DependRule
+   {
+   public:
+      Core::String              source;
+      std::vector<Core::String> deps;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::CPP
+{
+   static bool        DependEnabled = false;
+   static bool        DependOnly    = false;
+   static bool        DependSys     = true;
+   static char const *DependFile    = nullptr;
+   static char const *DependTarget  = nullptr;
+
+   static std::vector<DependRule> DependRules;
+}
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // -M
+   //
+   static Option::Function DependOpt
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName('M')
+         .setGroup("preprocessor")
+         .setDescS("Writes make dependencies.")
+         .setDescL("Writes make dependencies. The forms are:\n"
+            "-M  Writes dependencies instead of compiling, reading only "
+            "preprocessing directives. Output goes to the output file.\n"
+            "-MM  As -M, but omits files from system include directories.\n"
+            "-MD  Writes dependencies while compiling, to the output file "
+            "with its extension replaced by .d. If output is to stdout, the "
+            "first source's file name is used in place of the output.\n"
+            "-MMD  As -MD, but omits files from system include "
+            "directories.\n"
+            "-MF <file>  Sets the file to write dependencies to.\n"
+            "-MT <target>  Sets the rule target. The default is the output "
+            "file, or for -M the source file with its extension replaced by "
+            ".o."),
+
+      [](Option::Base *, Option::Args const &args) -> std::size_t
+      {
+         char const *mode = args.optAffix ? args.argV[0] : "";
+
+         if(*mode == 'M')
+            ++mode, DependSys = false;
+
+         switch(*mode)
+         {
+         case '\0':
+            DependEnabled = true;
+            DependOnly    = true;
+            return args.optAffix;
+
+         case 'D':
+            if(mode[1])
+               Option::Exception::Error(args, "unknown dependency option");
+
+            DependEnabled = true;
+            return 1;
+
+         case 'F':
+         case 'T':
+         {
+            char const *arg;
+            std::size_t used;
+
+            if(mode[1])
+               arg = mode + 1, used = 1;
+            else if(args.argC > 1)
+               arg = args.argV[1], used = 2;
+            else
+               Option::Exception::Error(args, "argument required");
+
+            (*mode == 'F' ? DependFile : DependTarget) = arg;
+            return used;
+         }
+
+         default:
+            Option::Exception::Error(args, "unknown dependency option");
+         }
+      }
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // PutDependName
+   //
+   // Writes a file name with make's special characters escaped.
+   //
+   static void PutDependName(std::ostream &out, char const *name)
+   {
+      for(; *name; ++name) switch(*name)
+      {
+      case ' ':
+      case '\t':
+      case '#': out << '\\' << *name; break;
+      case '$': out << "$$";          break;
+      default:  out << *name;         break;
+      }
+   }
+
+   //
+   // PutDependRule
+   //
+   static void PutDependRule(std::ostream &out, char const *target,
+      std::vector<Core::String> const &deps)
+   {
+      PutDependName(out, target);
+      out << ':';
+
+      for(auto const &dep : deps)
+      {
+         out << " \\\n ";
+         PutDependName(out, dep.data());
+      }
+
+      out << '\n';
+   }
+
+   //
+   // ReplaceExt
+   //
+   static std::string ReplaceExt(char const *name, char const *ext)
+   {
+      std::string str{name};
+      auto        dot = str.rfind('.');
+
+      if(dot != std::string::npos &&
+         dot >= str.size() - std::strlen(Core::PathFilename(name)))
+         str.resize(dot);
+
+      return str += ext;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // DependAdd
+   //
+   void DependAdd(char const *inName)
+   {
+      if(!DependEnabled)
+         return;
+
+      DependRule rule{inName, {inName}};
+
+      for(auto const &dep : Core::GetFileDepends())
+      {
+         if(DependSys || !dep.sys)
+            rule.deps.push_back(dep.name);
+      }
+
+      DependRules.push_back(std::move(rule));
+   }
+
+   //
+   // DependPut
+   //
+   void DependPut(char const *outName)
+   {
+      if(!DependEnabled)
+         return;
+
+      // Output to stdout has no name, so name the rule for the first source
+      // as if it were compiled to an object file.
+      std::string outObj;
+      if(!DependOnly && !std::strcmp(outName, "-") && !DependRules.empty())
+      {
+         outObj  = ReplaceExt(Core::PathFilename(DependRules.front().source.data()), ".o");
+         outName = outObj.data();
+      }
+
+      std::string file;
+      if(DependFile)
+         file = DependFile;
+      else if(DependOnly)
+         file = outName;
+      else
+         file = ReplaceExt(outName, ".d");
+
+      auto buf = Core::FileOpenStream(file.data(), std::ios_base::out);
+      std::ostream out{buf.get()};
+
+      // With -M, each source is its own target.
+      if(DependOnly)
+      {
+         for(auto const &rule : DependRules)
+         {
+            auto target = DependTarget ? std::string{DependTarget} :
+               ReplaceExt(Core::PathFilename(rule.source.data()), ".o");
+
+            PutDependRule(out, target.data(), rule.deps);
+         }
+
+         return;
+      }
+
+      // Otherwise, everything goes into the one output.
+      std::vector<Core::String> deps;
+      for(auto const &rule : DependRules)
+      {
+         for(auto const &dep : rule.deps)
+         {
+            if(std::find(deps.begin(), deps.end(), dep) == deps.end())
+               deps.push_back(dep);
+         }
+      }
+
+      PutDependRule(out, DependTarget ? DependTarget : outName, deps);
+   }
+
+   //
+   // DependScan
+   //
+   void DependScan(char const *inName)
+   {
+      auto buf = Core::FileOpenBlock(inName);
+
+      Core::String    file {inName};
+      IncludeLang     langs{"C"};
+      MacroMap        macr {Macro::Stringize(file)};
+      Core::String    path {Core::PathDirname(file)};
+      PragmaData      pragd{};
+      PragmaParser    pragp{pragd};
+      Core::StringBuf sbuf {buf->data(), buf->size()};
+      IStream         istr {sbuf, file};
+      TSource         tsrc {istr, istr.getOriginSource()};
+      IncStream       in   {tsrc, langs, macr, pragd, pragp, path};
+
+      Core::FileClearDepends();
+
+      Core::StatPhase phase{"depend"};
+
+      // Only the directive layers are run, so body text is passed through
+      // without macro expansion.
+      for(Core::Token tok; in >> tok;) {}
+
+      DependAdd(inName);
+   }
+
+   //
+   // IsDependOnly
+   //
+   bool IsDependOnly()
+   {
+      return DependOnly;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,40 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Make dependency output.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__CPP__Depend_H__
+#define GDCC__CPP__Depend_H__
+
+#include "../CPP/Types.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   // Adds the files listed by Core::GetFileDepends to the rule for inName.
+   void DependAdd(char const *inName);
+
+   // Writes the accumulated rules, if any were requested.
+   void DependPut(char const *outName);
+
+   // Reads a C source through the directive layers only, recording the
+   // files it includes.
+   void DependScan(char const *inName);
+
+   // Returns true if only dependencies are to be written (-M/-MM).
+   bool IsDependOnly();
+}
+
+#endif//GDCC__CPP__Depend_H__
+
@@ -80,13 +80,35 @@ namespace GDCC::CPP
 
       case Core::TOK_LnEnd:
          endl = true;
-         break;
+         goto flowed;
+
+      case Core::TOK_EOF:
+         goto flowed;
 
       default:
          endl = false;
          break;
       }
 
+      // Pass along the rest of the buffered line.
+      {
+         auto itr = buf + 1, end = buf + BufSize;
+
+         while(itr != end && src.avail())
+         {
+            auto tt = src.peek().tok;
+
+            if(tt == Core::TOK_Hash && endl) break;
+
+            *itr++ = src.get();
+
+            if(tt == Core::TOK_LnEnd) {endl = true; break;}
+            if(tt != Core::TOK_WSpace) endl = false;
+         }
+
+         return sett(buf, buf, itr);
+      }
+
    flowed:
       sett(buf, buf, buf + 1);
    }
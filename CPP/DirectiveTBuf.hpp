@@ -28,7 +28,8 @@ namespace GDCC::CPP
    // DirectiveTBuf
    //
    // Base class for handling preprocessor directives. Scans for lines starting
-   // with # and calls directive for them.
+   // with # and calls directive for them. Other tokens already buffered in
+   // src are passed along in blocks, up to the end of the line.
    //
    class DirectiveTBuf : public Core::TokenBuf
    {
@@ -36,6 +37,9 @@ namespace GDCC::CPP
       explicit DirectiveTBuf(Core::TokenBuf &src_) : src(src_),
          buf{Core::TokenEOF}, endl{true} {sett(buf, buf + 1, buf + 1);}
 
+
+      static constexpr std::size_t BufSize = 64;
+
    protected:
       //
       // directive
@@ -50,7 +54,7 @@ namespace GDCC::CPP
       virtual void underflow();
 
       Core::TokenBuf &src;
-      Core::Token     buf[2];
+      Core::Token     buf[BufSize];
 
       bool endl : 1;
    };
@@ -18,12 +18,14 @@
 #include "CPP/TStream.hpp"
 
 #include "Core/Exception.hpp"
+#include "Core/File.hpp"
 #include "Core/Option.hpp"
 #include "Core/Parse.hpp"
 #include "Core/Path.hpp"
 
 #include "Option/Bool.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -76,6 +78,25 @@ namespace GDCC::CPP
 }
 
 
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // IsPathUnder
+   //
+   static bool IsPathUnder(Core::String path, char const *base, std::size_t len)
+   {
+      while(len && Core::IsPathSep(base[len - 1])) --len;
+
+      return path.size() >= len && !std::strncmp(path.data(), base, len) &&
+         (path.size() == len || Core::IsPathSep(path[len]));
+   }
+}
+
+
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
 //
@@ -136,6 +157,17 @@ namespace GDCC::CPP
          Core::PathDirname(name)));
    }
 
+   //
+   // IncludeDTBuf::doIncFile
+   //
+   void IncludeDTBuf::doIncFile(Core::String name,
+      std::unique_ptr<std::streambuf> &&newBuf, bool sys)
+   {
+      Core::FileAddDepend(name, sys);
+
+      doInc(name, std::move(newBuf));
+   }
+
    //
    // IncludeDTBuf::doIncHdr
    //
@@ -215,6 +247,26 @@ namespace GDCC::CPP
          Core::Error(tok.pos, "invalid include syntax");
    }
 
+   //
+   // IncludeDTBuf::isSysDir
+   //
+   bool IncludeDTBuf::isSysDir() const
+   {
+      for(auto sys : IncludeSys)
+      {
+         if(IsPathUnder(dir, sys, std::strlen(sys)))
+            return true;
+      }
+
+      if(IncludeLangEnable) for(auto const &lang : langs)
+      {
+         if(IsPathUnder(dir, lang.data(), lang.size()))
+            return true;
+      }
+
+      return false;
+   }
+
    //
    // IncludeDTBuf::tryIncSys
    //
@@ -228,7 +280,7 @@ namespace GDCC::CPP
          std::string tmp{sys};
          Core::PathAppend(tmp, name);
          if(fbuf->open(tmp.data(), std::ios_base::in))
-            return doInc({tmp.data(), tmp.size()}, std::move(fbuf)), true;
+            return doIncFile({tmp.data(), tmp.size()}, std::move(fbuf), true), true;
       }
 
       // Try language directories.
@@ -236,7 +288,7 @@ namespace GDCC::CPP
       {
          Core::PathAppend(lang, name);
          if(fbuf->open(lang.data(), std::ios_base::in))
-            return doInc({lang.data(), lang.size()}, std::move(fbuf)), true;
+            return doIncFile({lang.data(), lang.size()}, std::move(fbuf), true), true;
       }
 
       return false;
@@ -249,13 +301,14 @@ namespace GDCC::CPP
    {
       std::unique_ptr<std::filebuf> fbuf{new std::filebuf()};
 
-      // Try current directory.
+      // Try current directory. Files beside a system header are also
+      // system headers.
       if(dir)
       {
          std::string tmp{dir.data(), dir.size()};
          Core::PathAppend(tmp, name);
          if(fbuf->open(tmp.data(), std::ios_base::in))
-            return doInc({tmp.data(), tmp.size()}, std::move(fbuf)), true;
+            return doIncFile({tmp.data(), tmp.size()}, std::move(fbuf), isSysDir()), true;
       }
 
       // Try specified directories.
@@ -264,7 +317,7 @@ namespace GDCC::CPP
          std::string tmp{usr};
          Core::PathAppend(tmp, name);
          if(fbuf->open(tmp.data(), std::ios_base::in))
-            return doInc({tmp.data(), tmp.size()}, std::move(fbuf)), true;
+            return doIncFile({tmp.data(), tmp.size()}, std::move(fbuf), false), true;
       }
 
       return false;
@@ -280,7 +333,17 @@ namespace GDCC::CPP
       if(inc)
       {
          if(*inc >> buf[0])
-            return sett(buf, buf, buf + 1);
+         {
+            // Pass along any other tokens already buffered by the include.
+            auto itr = buf + 1, end = buf + BufSize;
+            for(auto tbuf = inc->tkbuf(); itr != end && tbuf->avail() &&
+               tbuf->peek().tok != Core::TOK_EOF;)
+            {
+               *itr++ = tbuf->get();
+            }
+
+            return sett(buf, buf, itr);
+         }
 
          macros.lineDrop();
          inc.reset();
@@ -42,9 +42,14 @@ namespace GDCC::CPP
 
       virtual void doInc(Core::String name, std::unique_ptr<std::streambuf> &&buf);
 
+      void doIncFile(Core::String name, std::unique_ptr<std::streambuf> &&buf,
+         bool sys);
+
       bool doIncHdr(Core::String name, Core::Origin pos);
       bool doIncStr(Core::String name, Core::Origin pos);
 
+      bool isSysDir() const;
+
       void readInc(Core::Token const &tok);
 
       bool tryIncSys(Core::String name);
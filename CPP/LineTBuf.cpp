@@ -0,0 +1,64 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Line-buffered token source buffer.
+//
+//-----------------------------------------------------------------------------
+
+#include "CPP/LineTBuf.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // LineTBuf::underflow
+   //
+   void LineTBuf::underflow()
+   {
+      if(tptr() != tend()) return;
+
+      auto itr = buf, end = buf + BufSize;
+
+      do
+      {
+         auto &tok = *itr = src.getToken();
+         if(tok.tok == Core::TOK_EOF) break;
+         ++itr;
+
+         switch(tok.tok)
+         {
+         case Core::TOK_Hash:
+            // Stop before the directive name.
+            if(endl) dirl = true, end = itr;
+            endl = false;
+            break;
+
+         case Core::TOK_LnEnd:
+            dirl = false, endl = true, end = itr;
+            break;
+
+         case Core::TOK_WSpace:
+            break;
+
+         default:
+            endl = false;
+            break;
+         }
+      }
+      while(itr != end && !dirl);
+
+      sett(buf, buf, itr);
+   }
+}
+
+// EOF
+
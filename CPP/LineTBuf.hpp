@@ -0,0 +1,57 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Line-buffered token source buffer.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__CPP__LineTBuf_H__
+#define GDCC__CPP__LineTBuf_H__
+
+#include "../CPP/Types.hpp"
+
+#include "../Core/TokenBuf.hpp"
+#include "../Core/TokenSource.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // LineTBuf
+   //
+   // Reads tokens from source up to the end of the line, so that later
+   // buffers can pass them along in blocks. Directive lines are read one
+   // token at a time, as directives may change how the source tokenizes the
+   // rest of the line.
+   //
+   class LineTBuf : public Core::TokenBuf
+   {
+   public:
+      explicit LineTBuf(Core::TokenSource &src_) :
+         src(src_), dirl{false}, endl{true} {}
+
+
+      static constexpr std::size_t BufSize = 64;
+
+   protected:
+      virtual void underflow();
+
+      Core::Token        buf[BufSize];
+      Core::TokenSource &src;
+
+      bool dirl : 1; // If true, reading a directive line.
+      bool endl : 1; // If true, no tokens yet on the current line.
+   };
+}
+
+#endif//GDCC__CPP__LineTBuf_H__
+
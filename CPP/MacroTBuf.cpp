@@ -15,6 +15,7 @@
 #include "CPP/Macro.hpp"
 
 #include "Core/Exception.hpp"
+#include "Core/Stats.hpp"
 
 #include <cctype>
 #include <vector>
@@ -259,6 +260,8 @@ namespace GDCC::CPP
    //
    void MacroTBuf::expand(Itr e, Macro const &macro, Rng const &argRng)
    {
+      Core::StatAdd(Core::StatCount::Macros);
+
       auto argv = MakeArgs(macro, argRng);
 
       for(auto itr = macro.list.begin(), end = macro.list.end(); itr != end; ++itr)
@@ -365,6 +368,27 @@ namespace GDCC::CPP
       }
    }
 
+   //
+   // MacroTBuf::isPass
+   //
+   // Checks if a token can be passed along without going through expansion.
+   //
+   bool MacroTBuf::isPass(Core::Token const &tok)
+   {
+      switch(tok.tok)
+      {
+      case Core::TOK_EOF:
+      case Core::TOK_Marker:
+         return false;
+
+      case Core::TOK_Identi:
+         return ignoreAll || ignore.count(tok.str) || !macros.find(tok);
+
+      default:
+         return true;
+      }
+   }
+
    //
    // MacroTBuf::stringize
    //
@@ -401,6 +425,20 @@ namespace GDCC::CPP
 
       if(!buf.empty()) buf.pop_front();
 
+      // Pass along tokens that cannot be expanded in blocks, as long as they
+      // are already buffered in src.
+      if(buf.empty())
+      {
+         run.clear();
+
+         if(isPass(src.peek())) do
+            run.emplace_back(src.get());
+         while(src.avail() && isPass(src.peek()));
+
+         if(!run.empty())
+            return sett(run.data(), run.data(), run.data() + run.size());
+      }
+
       while(expand(buf.begin())) {}
 
       if(buf.empty())
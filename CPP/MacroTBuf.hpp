@@ -20,6 +20,7 @@
 
 #include <list>
 #include <unordered_set>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -51,7 +52,10 @@ namespace GDCC::CPP
 
       virtual void underflow();
 
-      std::list<Core::Token> buf;
+      bool isPass(Core::Token const &tok);
+
+      std::list<Core::Token>   buf;
+      std::vector<Core::Token> run;
 
       std::unordered_set<Core::String> ignore;
 
@@ -12,13 +12,12 @@
 
 #include "CPP/TSource.hpp"
 
+#include "Core/CharClass.hpp"
 #include "Core/Exception.hpp"
 #include "Core/Parse.hpp"
 #include "Core/Token.hpp"
 #include "Core/Warning.hpp"
 
-#include <cctype>
-
 
 //----------------------------------------------------------------------------|
 // Options                                                                    |
@@ -52,14 +51,6 @@ namespace GDCC::CPP
 
 namespace GDCC::CPP
 {
-   //
-   // IsIdentiChar
-   //
-   static bool IsIdentiChar(int c)
-   {
-      return std::isalnum(c) || c == '_' || c >= 0x80;
-   }
-
    //
    // ReadString
    //
@@ -183,7 +174,7 @@ namespace GDCC::CPP
 
       case '.':
          // Is this actually a number?
-         if(std::isdigit(in.peek())) break;
+         if(Core::IsCharDigit(in.peek())) break;
 
          c = in.get();
          if(c == '.') {c = in.get();
@@ -250,13 +241,10 @@ namespace GDCC::CPP
       }
 
       // Whitespace token.
-      if(std::isspace(c))
+      if(Core::IsCharSpace(c))
       {
-         std::string str;
-
-         do str += static_cast<char>(c);
-         while((c = in.get()) != EOF && (std::isspace(c) && c != '\n'));
-         if(c != EOF) in.unget();
+         std::string str{static_cast<char>(c)};
+         Core::ReadCharClass(in, str, Core::CharSpaceH);
 
          tok.str = {str.data(), str.size()};
          tok.tok = Core::TOK_WSpace;
@@ -271,7 +259,7 @@ namespace GDCC::CPP
       }
 
       // Number token.
-      if(std::isdigit(c) || c == '.')
+      if(Core::IsCharDigit(c) || c == '.')
       {
          in.putback(c);
 
@@ -283,12 +271,11 @@ namespace GDCC::CPP
       }
 
       // Identifier token.
-      if(IsIdentiChar(c))
+      if(Core::IsCharIdenti(c))
       {
-         std::string str;
-
-         do str += static_cast<char>(c);
-         while((c = in.get()) != EOF && IsIdentiChar(c));
+         std::string str{static_cast<char>(c)};
+         Core::ReadCharClass(in, str, Core::CharIdenti);
+         c = in.get();
 
          // Character/string with encoding prefix.
          if(c == '"')
@@ -16,6 +16,7 @@
 #include "../CPP/ConcatTBuf.hpp"
 #include "../CPP/ConditionDTBuf.hpp"
 #include "../CPP/IncludeDTBuf.hpp"
+#include "../CPP/LineTBuf.hpp"
 #include "../CPP/MacroDTBuf.hpp"
 #include "../CPP/MacroTBuf.hpp"
 #include "../CPP/PPTokenTBuf.hpp"
@@ -23,7 +24,6 @@
 #include "../CPP/StringTBuf.hpp"
 
 #include "../Core/BufferTBuf.hpp"
-#include "../Core/SourceTBuf.hpp"
 #include "../Core/TokenStream.hpp"
 #include "../Core/WSpaceTBuf.hpp"
 
@@ -58,7 +58,7 @@ namespace GDCC::CPP
       }
 
    protected:
-      using TBuf = Core::SourceTBuf<>;
+      using TBuf = LineTBuf;
       using CDir = ConditionDTBuf;
       using DDir = DefineDTBuf;
       using EDir = ErrorDTBuf;
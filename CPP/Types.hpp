@@ -34,6 +34,7 @@ namespace GDCC::CPP
    class IncludeDTBuf;
    class IncludeLang;
    class LineDTBuf;
+   class LineTBuf;
    class Macro;
    class MacroMap;
    class MacroTBuf;
@@ -10,6 +10,7 @@
 //
 //-----------------------------------------------------------------------------
 
+#include "CPP/Depend.hpp"
 #include "CPP/IStream.hpp"
 #include "CPP/Macro.hpp"
 #include "CPP/TStream.hpp"
@@ -18,6 +19,7 @@
 #include "Core/File.hpp"
 #include "Core/Option.hpp"
 #include "Core/Path.hpp"
+#include "Core/Stats.hpp"
 
 #include <iostream>
 
@@ -36,13 +38,29 @@ static void MakeCPP()
 {
    auto outName = GDCC::Core::GetOptionOutput();
 
+   // Only scan for dependencies?
+   if(GDCC::CPP::IsDependOnly())
+   {
+      for(auto const &arg : GDCC::Core::GetOptionArgs())
+         GDCC::CPP::DependScan(arg);
+
+      GDCC::CPP::DependPut(outName);
+      return;
+   }
+
    // Open output file.
    auto buf = GDCC::Core::FileOpenStream(outName, std::ios_base::out);
 
    // Process inputs.
    std::ostream out{buf.get()};
    for(auto const &arg : GDCC::Core::GetOptionArgs())
+   {
+      GDCC::Core::FileClearDepends();
       ProcessFile(out, arg);
+      GDCC::CPP::DependAdd(arg);
+   }
+
+   GDCC::CPP::DependPut(outName);
 }
 
 //
@@ -62,6 +80,7 @@ static void ProcessFile(std::ostream &out, char const *inName)
    GDCC::CPP::TSource      tsrc {istr, istr.getOriginSource()};
    GDCC::CPP::PPStream     in   {tsrc, langs, macr, pragd, pragp, path};
 
+   GDCC::Core::StatPhase phase{"preprocess"};
    for(GDCC::Core::Token tok; in >> tok;) switch(tok.tok)
    {
    case GDCC::Core::TOK_ChrU16: out << 'u'; goto case_Charac;
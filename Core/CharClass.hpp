@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Table-driven character classification for lexers.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Core__CharClass_H__
+#define GDCC__Core__CharClass_H__
+
+#include <istream>
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // CharClass
+   //
+   // Bits set in CharClassTable entries. These match the C locale's
+   // classification, since the lexers only accept the basic character set
+   // and treat every byte above 0x7F as part of an identifier.
+   //
+   enum CharClass : unsigned char
+   {
+      CharAlpha  = 0x01, // A-Z a-z
+      CharDigit  = 0x02, // 0-9
+      CharIdenti = 0x04, // A-Z a-z 0-9 _ and non-ASCII.
+      CharSpace  = 0x08, // Space, tab, newline, vertical tab, form feed, CR.
+      CharSpaceH = 0x10, // As CharSpace, but not newline.
+      CharUpper  = 0x20, // A-Z
+      CharWord   = 0x40, // A-Z a-z 0-9 _
+   };
+
+   //
+   // CharClassTable
+   //
+   class CharClassTable
+   {
+   public:
+      constexpr CharClassTable() : tab{}
+      {
+         for(int c = 0; c != 256; ++c)
+         {
+            unsigned char cls = 0;
+
+            if((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
+               cls |= CharAlpha | CharIdenti;
+
+            if(c >= 'A' && c <= 'Z')
+               cls |= CharUpper;
+
+            if(c >= '0' && c <= '9')
+               cls |= CharDigit | CharIdenti;
+
+            if(c == '_' || c >= 0x80)
+               cls |= CharIdenti;
+
+            if((cls & (CharAlpha | CharDigit)) || c == '_')
+               cls |= CharWord;
+
+            if(c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r')
+               cls |= CharSpace;
+
+            if(c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r')
+               cls |= CharSpaceH;
+
+            tab[c] = cls;
+         }
+      }
+
+      constexpr unsigned char operator [] (int c) const
+         {return c >= 0 && c < 256 ? tab[c] : 0;}
+
+   private:
+      unsigned char tab[256];
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   inline constexpr CharClassTable CharClassTab{};
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // IsCharClass
+   //
+   // Checks if a character (as returned by std::istream::get) has any of the
+   // given class bits. EOF has no class.
+   //
+   constexpr bool IsCharClass(int c, unsigned cls) {return CharClassTab[c] & cls;}
+
+   constexpr bool IsCharAlpha(int c)  {return IsCharClass(c, CharAlpha);}
+   constexpr bool IsCharDigit(int c)  {return IsCharClass(c, CharDigit);}
+   constexpr bool IsCharIdenti(int c) {return IsCharClass(c, CharIdenti);}
+   constexpr bool IsCharSpace(int c)  {return IsCharClass(c, CharSpace);}
+   constexpr bool IsCharSpaceH(int c) {return IsCharClass(c, CharSpaceH);}
+
+   //
+   // ToCharLower
+   //
+   constexpr int ToCharLower(int c) {return IsCharClass(c, CharUpper) ? c | 0x20 : c;}
+
+   //
+   // ReadCharClass
+   //
+   // Appends characters to str for as long as they have any of the given
+   // class bits. Reads directly from the stream buffer, leaving the first
+   // non-matching character unread, so no unget is needed afterwards.
+   //
+   inline void ReadCharClass(std::istream &in, std::string &str, unsigned cls)
+   {
+      auto buf = in.rdbuf();
+
+      for(int c; IsCharClass(c = buf->sgetc(), cls); buf->sbumpc())
+         str += static_cast<char>(c);
+   }
+
+   //
+   // ReadCharClassLower
+   //
+   // As ReadCharClass, but converts A-Z to lowercase.
+   //
+   inline void ReadCharClassLower(std::istream &in, std::string &str, unsigned cls)
+   {
+      auto buf = in.rdbuf();
+
+      for(int c; IsCharClass(c = buf->sgetc(), cls); buf->sbumpc())
+         str += static_cast<char>(ToCharLower(c));
+   }
+}
+
+#endif//GDCC__Core__CharClass_H__
+
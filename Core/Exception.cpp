@@ -14,6 +14,9 @@
 
 #include "Core/Token.hpp"
 
+#include <cstring>
+#include <string>
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
@@ -24,17 +27,19 @@ namespace GDCC::Core
    //
    // ExceptFile
    //
+   // Does not use String, so that it can be thrown from worker threads.
+   //
    class ExceptFile : public Exception
    {
    public:
-      ExceptFile(String filename_, String mode_) noexcept :
-         Exception{}, filename{filename_}, mode{mode_} {}
+      ExceptFile(char const *filename_, std::size_t len, char const *mode_) :
+         Exception{}, filename{filename_, len}, mode{mode_} {}
 
    protected:
       virtual char const *whatGen() const noexcept;
 
-      String const filename;
-      String const mode;
+      std::string const filename;
+      char const *const mode;
    };
 
    //
@@ -324,7 +329,9 @@ namespace GDCC::Core
    // ErrorFile
    //
    void ErrorFile(String filename, char const *mode)
-      {throw ExceptFile(filename, mode);}
+      {throw ExceptFile(filename.data(), filename.size(), mode);}
+   void ErrorFile(char const *filename, char const *mode)
+      {throw ExceptFile(filename, std::strlen(filename), mode);}
 
    //
    // ErrorFileInc
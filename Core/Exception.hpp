@@ -80,6 +80,9 @@ namespace GDCC::Core
 
    [[noreturn]]
    void ErrorFile(String filename, char const *mode);
+   // Safe to call from any thread.
+   [[noreturn]]
+   void ErrorFile(char const *filename, char const *mode);
 
    [[noreturn]]
    void ErrorFileInc(Origin pos, String filename);
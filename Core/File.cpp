@@ -15,6 +15,7 @@
 #include "Core/Exception.hpp"
 #include "Core/String.hpp"
 
+#include <cerrno>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -33,6 +34,16 @@
 #endif
 
 
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   static std::vector<FileDepend> FileDepends;
+}
+
+
 //----------------------------------------------------------------------------|
 // Types                                                                      |
 //
@@ -75,6 +86,26 @@ namespace GDCC::Core
       char       *const fileData;
       std::size_t const fileSize;
    };
+
+   //
+   // FileOutput_POSIX
+   //
+   class FileOutput_POSIX : public FileOutput
+   {
+   public:
+      FileOutput_POSIX(int fd_, char const *name_) : fd{fd_}, name{name_} {}
+      virtual ~FileOutput_POSIX() {close(fd);}
+
+   protected:
+      virtual void v_write(std::size_t pos, char const *data, std::size_t size);
+
+      virtual void v_writeFile(std::size_t pos, char const *filename, std::size_t size);
+
+   private:
+      // Not a String, so that files can be written concurrently.
+      int         const fd;
+      std::string const name;
+   };
    #endif
 }
 
@@ -85,6 +116,17 @@ namespace GDCC::Core
 
 namespace GDCC::Core
 {
+   //
+   // FileAddDepend
+   //
+   void FileAddDepend(String filename, bool sys)
+   {
+      for(auto const &dep : FileDepends)
+         if(dep.name == filename) return;
+
+      FileDepends.push_back({filename, sys});
+   }
+
    //
    // FileBlock::getHash
    //
@@ -96,6 +138,14 @@ namespace GDCC::Core
       return cacheHash;
    }
 
+   //
+   // FileClearDepends
+   //
+   void FileClearDepends()
+   {
+      FileDepends.clear();
+   }
+
    //
    // FileOpenBlock
    //
@@ -173,6 +223,53 @@ namespace GDCC::Core
       #endif
    }
 
+   //
+   // FileOpenOutput
+   //
+   std::unique_ptr<FileOutput> FileOpenOutput(char const *filename)
+   {
+      #ifdef _WIN32
+      return nullptr;
+      #else
+      // Special file: -
+      if(filename[0] == '-' && filename[1] == '\0')
+         return nullptr;
+
+      // Only regular files can be written out of order.
+      struct stat statBuf;
+      if(!stat(filename, &statBuf) && !S_ISREG(statBuf.st_mode))
+         return nullptr;
+
+      int fd;
+      // The file is not extended to its size in advance, as writing into
+      // the resulting hole is slower on some filesystems.
+      if((fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0666)) == -1)
+         ErrorFile(filename, "writing");
+
+      return std::unique_ptr<FileOutput>{new FileOutput_POSIX{fd, filename}};
+      #endif
+   }
+
+   //
+   // FileOpenUpdate
+   //
+   std::unique_ptr<FileOutput> FileOpenUpdate(char const *filename)
+   {
+      #ifdef _WIN32
+      return nullptr;
+      #else
+      struct stat statBuf;
+      if(stat(filename, &statBuf) || !S_ISREG(statBuf.st_mode))
+         return nullptr;
+
+      int fd;
+      if((fd = open(filename, O_WRONLY)) == -1)
+         return nullptr;
+
+      return std::unique_ptr<FileOutput>{new FileOutput_POSIX{fd, filename}};
+      #endif
+   }
+
    //
    // FileOpenStream
    //
@@ -217,6 +314,79 @@ namespace GDCC::Core
       }
    }
 
+   //
+   // FileOutput::v_writeFile
+   //
+   void FileOutput::v_writeFile(std::size_t pos, char const *filename, std::size_t size)
+   {
+      auto buf = FileOpenBlock(filename);
+
+      if(buf->size() != size)
+         ErrorFile(filename, "reading");
+
+      v_write(pos, buf->data(), size);
+   }
+
+   #ifndef _WIN32
+   //
+   // FileOutput_POSIX::v_write
+   //
+   void FileOutput_POSIX::v_write(std::size_t pos, char const *data, std::size_t size)
+   {
+      while(size)
+      {
+         auto n = pwrite(fd, data, size, pos);
+
+         if(n == -1)
+         {
+            if(errno == EINTR) continue;
+            ErrorFile(name.data(), "writing");
+         }
+
+         data += n;
+         size -= n;
+         pos  += n;
+      }
+   }
+
+   //
+   // FileOutput_POSIX::v_writeFile
+   //
+   void FileOutput_POSIX::v_writeFile(std::size_t pos, char const *filename,
+      std::size_t size)
+   {
+      #ifdef __linux__
+      // Have the kernel copy the data, which may avoid copying it at all.
+      // If that is not supported for these files, fall back to mapping.
+      int in;
+      if((in = open(filename, O_RDONLY)) == -1)
+         ErrorFile(filename, "reading");
+
+      loff_t inPos = 0, outPos = pos;
+      std::size_t left = size;
+
+      while(left)
+      {
+         auto n = copy_file_range(in, &inPos, fd, &outPos, left, 0);
+
+         if(n > 0)
+            left -= n;
+         else if(n == -1 && errno == EINTR)
+            continue;
+         else
+            break;
+      }
+
+      close(in);
+
+      if(!left)
+         return;
+      #endif
+
+      FileOutput::v_writeFile(pos, filename, size);
+   }
+   #endif
+
    //
    // FileSize
    //
@@ -229,6 +399,14 @@ namespace GDCC::Core
 
       return statBuf.st_size;
    }
+
+   //
+   // GetFileDepends
+   //
+   std::vector<FileDepend> const &GetFileDepends()
+   {
+      return FileDepends;
+   }
 }
 
 // EOF
@@ -14,9 +14,11 @@
 #define GDCC__Core__File_H__
 
 #include "../Core/Deleter.hpp"
+#include "../Core/String.hpp"
 
 #include <memory>
 #include <streambuf>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -25,6 +27,16 @@
 
 namespace GDCC::Core
 {
+   //
+   // FileDepend
+   //
+   class FileDepend
+   {
+   public:
+      String name;
+      bool   sys; // Found in a system include directory.
+   };
+
    //
    // FileBlock
    //
@@ -51,6 +63,30 @@ namespace GDCC::Core
    private:
       mutable std::size_t cacheHash = 0;
    };
+
+   //
+   // FileOutput
+   //
+   // An output file written at explicit positions, so that separate parts
+   // of it can be written concurrently.
+   //
+   class FileOutput
+   {
+   public:
+      virtual ~FileOutput() {}
+
+      void write(std::size_t pos, char const *data, std::size_t size)
+         {v_write(pos, data, size);}
+
+      // Writes the contents of a file, which must be size bytes long.
+      void writeFile(std::size_t pos, char const *filename, std::size_t size)
+         {v_writeFile(pos, filename, size);}
+
+   protected:
+      virtual void v_write(std::size_t pos, char const *data, std::size_t size) = 0;
+
+      virtual void v_writeFile(std::size_t pos, char const *filename, std::size_t size);
+   };
 }
 
 
@@ -60,12 +96,28 @@ namespace GDCC::Core
 
 namespace GDCC::Core
 {
+   // Records a file read while processing the current source, such as an
+   // included header. Each file is only recorded once.
+   void FileAddDepend(String filename, bool sys = false);
+
+   void FileClearDepends();
+
    std::unique_ptr<FileBlock> FileOpenBlock(char const *filename);
 
+   // Opens a regular file for output at positions, truncating it. If the
+   // file cannot be written that way, such as for -, returns null.
+   std::unique_ptr<FileOutput> FileOpenOutput(char const *filename);
+
+   // Opens an existing regular file for output at positions, keeping its
+   // contents. If the file cannot be written that way, returns null.
+   std::unique_ptr<FileOutput> FileOpenUpdate(char const *filename);
+
    std::unique_ptr<std::streambuf, ConditionalDeleter<std::streambuf>>
    FileOpenStream(char const *filename, std::ios_base::openmode which);
 
    std::size_t FileSize(char const *filename);
+
+   std::vector<FileDepend> const &GetFileDepends();
 }
 
 #endif//GDCC__Core__File_H__
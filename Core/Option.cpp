@@ -12,7 +12,11 @@
 
 #include "Core/Option.hpp"
 
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
 #include "Core/Path.hpp"
+#include "Core/SHA256.hpp"
+#include "Core/Stats.hpp"
 
 #include "Option/Exception.hpp"
 
@@ -144,6 +148,36 @@ namespace GDCC::Core
       return GetOptions().args;
    }
 
+   //
+   // GetOptionBuild
+   //
+   // Anything stored for reuse by later runs is keyed on this, so that a
+   // rebuilt program does not trust the results of an older one.
+   //
+   std::string const &GetOptionBuild()
+   {
+      static std::string const build = []() -> std::string
+      {
+         for(auto name : {"/proc/self/exe", GetOptions().argv0})
+         {
+            if(!name) continue;
+
+            try
+            {
+               auto buf = FileOpenBlock(name);
+               return GetSHA256Hex(buf->data(), buf->size());
+            }
+            catch(Exception const &)
+            {
+            }
+         }
+
+         return {};
+      }();
+
+      return build;
+   }
+
    //
    // GetOptionLibPath
    //
@@ -197,6 +231,9 @@ namespace GDCC::Core
          throw EXIT_SUCCESS;
       }
 
+      opts.argv.assign(argv + 1, argv + argc);
+      opts.argv0 = argv[0];
+
       try
       {
          opts.list.process(Option::Args().setArgs(argv + 1, argc - 1).setOptKeepA());
@@ -216,6 +253,8 @@ namespace GDCC::Core
          std::cerr << "No output specified. Use -h for usage.\n";
          throw EXIT_FAILURE;
       }
+
+      StatsInit();
    }
 }
 
@@ -20,6 +20,8 @@
 #include "../Option/Function.hpp"
 #include "../Option/Program.hpp"
 
+#include <vector>
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
@@ -61,6 +63,12 @@ namespace GDCC::Core
 
       Option::CStr       optLibPath;
       SystemSourceOption optSysSource;
+
+      // Unprocessed arguments, excluding the program name.
+      std::vector<char const *> argv;
+
+      // Program name as invoked.
+      char const *argv0 = nullptr;
    };
 }
 
@@ -73,6 +81,10 @@ namespace GDCC::Core
 {
    Option::CStrV &GetOptionArgs();
 
+   // Returns the SHA-256 digest of the running executable, or an empty
+   // string if it cannot be read.
+   std::string const &GetOptionBuild();
+
    std::string GetOptionLibPath();
 
    Option::Program &GetOptionList();
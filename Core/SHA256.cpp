@@ -0,0 +1,223 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// SHA-256 message digests.
+//
+//-----------------------------------------------------------------------------
+
+#include "Core/SHA256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   static std::uint_least32_t const SHA256Round[64] =
+   {
+      0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+      0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+      0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+      0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+      0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+      0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+      0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+      0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+      0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+      0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+      0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+      0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+      0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+      0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+      0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+      0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // RotR
+   //
+   static std::uint_least32_t RotR(std::uint_least32_t x, unsigned n)
+   {
+      return ((x >> n) | (x << (32 - n))) & 0xFFFFFFFF;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // SHA256 constructor
+   //
+   SHA256::SHA256() :
+      state{0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+            0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19},
+      buf{},
+      bufLen{0},
+      total{0}
+   {
+   }
+
+   //
+   // SHA256::block
+   //
+   void SHA256::block(unsigned char const *data)
+   {
+      std::uint_least32_t w[64];
+
+      for(int i = 0; i != 16; ++i)
+      {
+         w[i] =
+            static_cast<std::uint_least32_t>(data[i * 4 + 0]) << 24 |
+            static_cast<std::uint_least32_t>(data[i * 4 + 1]) << 16 |
+            static_cast<std::uint_least32_t>(data[i * 4 + 2]) <<  8 |
+            static_cast<std::uint_least32_t>(data[i * 4 + 3]);
+      }
+
+      for(int i = 16; i != 64; ++i)
+      {
+         auto s0 = RotR(w[i - 15], 7) ^ RotR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+         auto s1 = RotR(w[i - 2], 17) ^ RotR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+         w[i] = (w[i - 16] + s0 + w[i - 7] + s1) & 0xFFFFFFFF;
+      }
+
+      auto a = state[0], b = state[1], c = state[2], d = state[3];
+      auto e = state[4], f = state[5], g = state[6], h = state[7];
+
+      for(int i = 0; i != 64; ++i)
+      {
+         auto s1 = RotR(e, 6) ^ RotR(e, 11) ^ RotR(e, 25);
+         auto ch = (e & f) ^ (~e & g);
+         auto t1 = (h + s1 + ch + SHA256Round[i] + w[i]) & 0xFFFFFFFF;
+         auto s0 = RotR(a, 2) ^ RotR(a, 13) ^ RotR(a, 22);
+         auto mj = (a & b) ^ (a & c) ^ (b & c);
+         auto t2 = (s0 + mj) & 0xFFFFFFFF;
+
+         h = g; g = f; f = e; e = (d + t1) & 0xFFFFFFFF;
+         d = c; c = b; b = a; a = (t1 + t2) & 0xFFFFFFFF;
+      }
+
+      state[0] = (state[0] + a) & 0xFFFFFFFF;
+      state[1] = (state[1] + b) & 0xFFFFFFFF;
+      state[2] = (state[2] + c) & 0xFFFFFFFF;
+      state[3] = (state[3] + d) & 0xFFFFFFFF;
+      state[4] = (state[4] + e) & 0xFFFFFFFF;
+      state[5] = (state[5] + f) & 0xFFFFFFFF;
+      state[6] = (state[6] + g) & 0xFFFFFFFF;
+      state[7] = (state[7] + h) & 0xFFFFFFFF;
+   }
+
+   //
+   // SHA256::finish
+   //
+   SHA256::Digest SHA256::finish()
+   {
+      auto bits = total * 8;
+
+      buf[bufLen++] = 0x80;
+      if(bufLen > 56)
+      {
+         std::memset(buf + bufLen, 0, 64 - bufLen);
+         block(buf);
+         bufLen = 0;
+      }
+
+      std::memset(buf + bufLen, 0, 56 - bufLen);
+      for(int i = 0; i != 8; ++i)
+         buf[56 + i] = static_cast<unsigned char>(bits >> (56 - i * 8));
+      block(buf);
+
+      Digest digest;
+      for(int i = 0; i != 32; ++i)
+         digest[i] = static_cast<unsigned char>(state[i / 4] >> (24 - i % 4 * 8));
+
+      return digest;
+   }
+
+   //
+   // SHA256::update
+   //
+   void SHA256::update(char const *data, std::size_t size)
+   {
+      auto itr = reinterpret_cast<unsigned char const *>(data);
+
+      total += size;
+
+      if(bufLen)
+      {
+         auto len = std::min<std::size_t>(64 - bufLen, size);
+         std::memcpy(buf + bufLen, itr, len);
+         bufLen += len; itr += len; size -= len;
+
+         if(bufLen != 64)
+            return;
+
+         block(buf);
+         bufLen = 0;
+      }
+
+      for(; size >= 64; itr += 64, size -= 64)
+         block(itr);
+
+      std::memcpy(buf, itr, size);
+      bufLen = size;
+   }
+
+   //
+   // GetSHA256
+   //
+   SHA256::Digest GetSHA256(char const *data, std::size_t size)
+   {
+      SHA256 sha;
+      sha.update(data, size);
+      return sha.finish();
+   }
+
+   //
+   // GetSHA256Hex
+   //
+   std::string GetSHA256Hex(SHA256::Digest const &digest)
+   {
+      static char const hex[] = "0123456789abcdef";
+
+      std::string str;
+      for(auto c : digest)
+      {
+         str += hex[c >> 4];
+         str += hex[c & 0xF];
+      }
+
+      return str;
+   }
+
+   //
+   // GetSHA256Hex
+   //
+   std::string GetSHA256Hex(char const *data, std::size_t size)
+   {
+      return GetSHA256Hex(GetSHA256(data, size));
+   }
+}
+
+// EOF
+
@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// SHA-256 message digests.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Core__SHA256_H__
+#define GDCC__Core__SHA256_H__
+
+#include "../Core/Types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // SHA256
+   //
+   // Computes a digest incrementally.
+   //
+   class SHA256
+   {
+   public:
+      using Digest = std::array<unsigned char, 32>;
+
+
+      SHA256();
+
+      Digest finish();
+
+      void update(char const *data, std::size_t size);
+
+   private:
+      void block(unsigned char const *data);
+
+      std::uint_least32_t state[8];
+      unsigned char       buf[64];
+      std::size_t         bufLen;
+      std::uint_least64_t total;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   SHA256::Digest GetSHA256(char const *data, std::size_t size);
+
+   // Returns the digest as lowercase hexadecimal.
+   std::string GetSHA256Hex(SHA256::Digest const &digest);
+   std::string GetSHA256Hex(char const *data, std::size_t size);
+}
+
+#endif//GDCC__Core__SHA256_H__
+
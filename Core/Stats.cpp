@@ -0,0 +1,284 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Phase timing and counters.
+//
+//-----------------------------------------------------------------------------
+
+#include "Core/Stats.hpp"
+
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+
+#include "Option/Bool.hpp"
+#include "Option/CStr.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::Core
+{
+   //
+   // --stats
+   //
+   static Option::CStr StatsFile
+   {
+      &GetOptionList(), Option::Base::Info()
+         .setName("stats")
+         .setGroup("output")
+         .setDescS("Writes phase timings and counters as JSON.")
+         .setDescL("Writes phase timings and counters as JSON to the given "
+            "file when the program exits. Use - to write to stdout.")
+   };
+
+   //
+   // --time-report
+   //
+   static Option::Bool TimeReport
+   {
+      &GetOptionList(), Option::Base::Info()
+         .setName("time-report")
+         .setGroup("output")
+         .setDescS("Prints phase timings and counters.")
+         .setDescL("Prints phase timings, counters, and peak memory use to "
+            "stderr when the program exits. Default off."),
+
+      false
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // StatPhaseData
+   //
+   class StatPhaseData
+   {
+   public:
+      char const                         *name;
+      std::size_t                         calls;
+      std::chrono::steady_clock::duration time;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   static char const *const StatCountNames[] =
+   {
+      "tokens",
+      "macro-expansions",
+      "ir-statements",
+      "helper-functions",
+      "strings",
+   };
+
+   // Must be constructed before StatsInit registers PutStatsAtExit, so that
+   // it is still alive when that runs.
+   static std::vector<StatPhaseData> StatPhases;
+
+   static std::chrono::steady_clock::time_point StatStart;
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   bool StatsEnabled = false;
+
+   std::size_t StatCounts[static_cast<std::size_t>(StatCount::None)];
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // GetPeakRSS
+   //
+   // Returns peak resident set size in bytes, or 0 if unknown.
+   //
+   static std::size_t GetPeakRSS()
+   {
+      #ifndef _WIN32
+      rusage usage;
+      if(getrusage(RUSAGE_SELF, &usage))
+         return 0;
+
+      #ifdef __APPLE__
+      return usage.ru_maxrss;
+      #else
+      return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+      #endif
+      #else
+      return 0;
+      #endif
+   }
+
+   //
+   // GetSeconds
+   //
+   static double GetSeconds(std::chrono::steady_clock::duration time)
+   {
+      return std::chrono::duration<double>(time).count();
+   }
+
+   //
+   // PutStatsAtExit
+   //
+   static void PutStatsAtExit()
+   {
+      if(TimeReport)
+         PutStats(std::cerr);
+
+      if(StatsFile.data()) try
+      {
+         auto buf = FileOpenStream(StatsFile.data(), std::ios_base::out);
+         std::ostream out{buf.get()};
+         PutStatsJSON(out);
+      }
+      catch(std::exception const &e)
+      {
+         std::cerr << "ERROR: " << e.what() << std::endl;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // StatPhaseAdd
+   //
+   void StatPhaseAdd(char const *name, std::chrono::steady_clock::duration time)
+   {
+      for(auto &phase : StatPhases)
+      {
+         if(phase.name == name || !std::strcmp(phase.name, name))
+         {
+            ++phase.calls;
+            phase.time += time;
+            return;
+         }
+      }
+
+      StatPhases.push_back({name, 1, time});
+   }
+
+   //
+   // StatsInit
+   //
+   void StatsInit()
+   {
+      if(!TimeReport && !StatsFile.data())
+         return;
+
+      StatsEnabled = true;
+      StatStart    = std::chrono::steady_clock::now();
+
+      std::atexit(PutStatsAtExit);
+   }
+
+   //
+   // PutStats
+   //
+   void PutStats(std::ostream &out)
+   {
+      auto total = std::chrono::steady_clock::now() - StatStart;
+
+      out << GetOptions().list.name << " time report:\n"
+         << std::fixed << std::setprecision(3);
+
+      for(auto const &phase : StatPhases)
+      {
+         out << "  " << std::left << std::setw(16) << phase.name
+            << std::right << std::setw(8) << phase.calls << " calls "
+            << std::setw(10) << GetSeconds(phase.time) << "s\n";
+      }
+
+      out << "  " << std::left << std::setw(30) << "total"
+         << std::right << std::setw(10) << GetSeconds(total) << "s\n";
+
+      for(std::size_t i = 0; i != static_cast<std::size_t>(StatCount::None); ++i)
+      {
+         out << "  " << std::left << std::setw(16) << StatCountNames[i]
+            << std::right << std::setw(14) << StatCounts[i] << '\n';
+      }
+
+      if(auto rss = GetPeakRSS())
+      {
+         out << "  " << std::left << std::setw(16) << "peak-rss"
+            << std::right << std::setw(14) << rss / 1024 << " KiB\n";
+      }
+   }
+
+   //
+   // PutStatsJSON
+   //
+   void PutStatsJSON(std::ostream &out)
+   {
+      auto &opts  = GetOptions();
+      auto  total = std::chrono::steady_clock::now() - StatStart;
+
+      out << "{\n  \"tool\": \"" << opts.list.name << "\",\n"
+         "  \"version\": \"" << opts.list.version << "\",\n"
+         "  \"seconds\": " << std::setprecision(9) << GetSeconds(total) << ",\n"
+         "  \"phases\": [";
+
+      bool first = true;
+      for(auto const &phase : StatPhases)
+      {
+         out << (first ? "\n" : ",\n") << "    {\"name\": \"" << phase.name
+            << "\", \"calls\": " << phase.calls << ", \"seconds\": "
+            << GetSeconds(phase.time) << '}';
+
+         first = false;
+      }
+
+      out << "\n  ],\n  \"counters\": {";
+
+      for(std::size_t i = 0; i != static_cast<std::size_t>(StatCount::None); ++i)
+         out << (i ? ",\n" : "\n") << "    \"" << StatCountNames[i] << "\": " << StatCounts[i];
+
+      out << "\n  },\n  \"peak-rss\": " << GetPeakRSS() << "\n}\n";
+   }
+}
+
+// EOF
+
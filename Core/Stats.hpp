@@ -0,0 +1,119 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Phase timing and counters.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Core__Stats_H__
+#define GDCC__Core__Stats_H__
+
+#include "../Core/Types.hpp"
+
+#include <chrono>
+#include <ostream>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // StatCount
+   //
+   enum class StatCount
+   {
+      Tokens,
+      Macros,
+      Stmnts,
+      Helpers,
+      Strings,
+
+      None
+   };
+
+   //
+   // StatPhase
+   //
+   // Times a named phase for the lifetime of the object. When statistics are
+   // not enabled, construction and destruction only test a flag. Nested
+   // phases are included in the time of the enclosing phase.
+   //
+   class StatPhase
+   {
+   public:
+      explicit StatPhase(char const *name);
+      StatPhase(StatPhase const &) = delete;
+      ~StatPhase();
+
+   private:
+      using Clock = std::chrono::steady_clock;
+
+      char const       *name;
+      Clock::time_point start;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   extern bool StatsEnabled;
+
+   extern std::size_t StatCounts[static_cast<std::size_t>(StatCount::None)];
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // StatAdd
+   //
+   inline void StatAdd(StatCount count, std::size_t n = 1)
+   {
+      StatCounts[static_cast<std::size_t>(count)] += n;
+   }
+
+   void StatPhaseAdd(char const *name, std::chrono::steady_clock::duration time);
+
+   // Enables statistics if requested by options, and arranges for them to be
+   // written when the program exits. Called by ProcessOptions.
+   void StatsInit();
+
+   void PutStats(std::ostream &out);
+   void PutStatsJSON(std::ostream &out);
+
+   //
+   // StatPhase constructor
+   //
+   inline StatPhase::StatPhase(char const *name_) :
+      name{StatsEnabled ? name_ : nullptr}
+   {
+      if(name) start = Clock::now();
+   }
+
+   //
+   // StatPhase destructor
+   //
+   inline StatPhase::~StatPhase()
+   {
+      if(name) StatPhaseAdd(name, Clock::now() - start);
+   }
+}
+
+#endif//GDCC__Core__Stats_H__
+
@@ -12,6 +12,8 @@
 
 #include "Core/String.hpp"
 
+#include "Core/Stats.hpp"
+
 #include <cctype>
 #include <cstring>
 #include <tuple>
@@ -221,6 +223,7 @@ namespace GDCC::Core
       std::size_t idx = StringTable().size();
 
       StringTable().emplace_back(str, len, hash, idx);
+      StatAdd(StatCount::Strings);
 
       String::DataC = StringTable().size();
       String::DataV = StringTable().data();
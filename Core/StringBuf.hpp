@@ -47,6 +47,40 @@ namespace GDCC::Core
          char *str = const_cast<char *>(str_);
          setg(str, str, str + len);
       }
+
+   protected:
+      //
+      // seekoff
+      //
+      virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+         std::ios_base::openmode which)
+      {
+         if(!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+
+         char *base;
+         switch(dir)
+         {
+         case std::ios_base::beg: base = eback(); break;
+         case std::ios_base::cur: base = gptr();  break;
+         case std::ios_base::end: base = egptr(); break;
+         default: return pos_type(off_type(-1));
+         }
+
+         if(off < eback() - base || off > egptr() - base)
+            return pos_type(off_type(-1));
+
+         setg(eback(), base + off, egptr());
+         return pos_type(gptr() - eback());
+      }
+
+      //
+      // seekpos
+      //
+      virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+      {
+         return seekoff(off_type(pos), std::ios_base::beg, which);
+      }
    };
 
    //
@@ -29,6 +29,9 @@ GDCC_Core_StringList(__arg, "__arg")
 GDCC_Core_StringList(__asm, "__asm")
 GDCC_Core_StringList(__attribute__, "__attribute__")
 GDCC_Core_StringList(__aut, "__aut")
+GDCC_Core_StringList(__builtin_memcpy, "__builtin_memcpy")
+GDCC_Core_StringList(__builtin_memmove, "__builtin_memmove")
+GDCC_Core_StringList(__builtin_memset, "__builtin_memset")
 GDCC_Core_StringList(__call, "__call")
 GDCC_Core_StringList(__deprecated, "__deprecated")
 GDCC_Core_StringList(__delay, "__delay")
@@ -378,6 +381,9 @@ GDCC_Core_StringList(localReg, "localReg")
 GDCC_Core_StringList(log, "log")
 GDCC_Core_StringList(long, "long")
 GDCC_Core_StringList(map, "map")
+GDCC_Core_StringList(memcpy, "memcpy")
+GDCC_Core_StringList(memmove, "memmove")
+GDCC_Core_StringList(memset, "memset")
 GDCC_Core_StringList(module, "module")
 GDCC_Core_StringList(more, "more")
 GDCC_Core_StringList(multiDef, "multiDef")
@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// String-keyed tables.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Core__StringTable_H__
+#define GDCC__Core__StringTable_H__
+
+#include "../Core/String.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // StringTable
+   //
+   // Maps strings to values using the string's index as its hash, so lookups
+   // never touch the string data. Slots are open addressed with linear
+   // probing. Entries are kept in insertion order and never move once added.
+   //
+   template<typename T>
+   class StringTable
+   {
+   public:
+      using value_type = std::pair<String, T>;
+
+      using Storage = std::deque<value_type>;
+
+      using const_iterator = typename Storage::const_iterator;
+      using iterator       = typename Storage::iterator;
+      using size_type      = std::size_t;
+
+
+      T &operator [] (String key) {return get(key);}
+
+      iterator       begin()       {return data.begin();}
+      const_iterator begin() const {return data.begin();}
+
+      void clear() {data.clear(); slots.clear();}
+
+      bool empty() const {return data.empty();}
+
+      iterator       end()       {return data.end();}
+      const_iterator end() const {return data.end();}
+
+      T       *find(String key)       {return findEntry(key);}
+      T const *find(String key) const {return findEntry(key);}
+
+      // Returns the key's value, constructing it from args if not present.
+      template<typename... Args>
+      T &get(String key, Args &&...args)
+      {
+         if(data.size() * 2 >= slots.size())
+            grow();
+
+         auto &slot = slots[findSlot(key)];
+         if(!slot.val)
+         {
+            data.emplace_back(std::piecewise_construct,
+               std::forward_as_tuple(key),
+               std::forward_as_tuple(std::forward<Args>(args)...));
+
+            slot.key = static_cast<std::size_t>(key);
+            slot.val = data.size();
+         }
+
+         return data[slot.val - 1].second;
+      }
+
+      size_type size() const {return data.size();}
+
+   private:
+      //
+      // Slot
+      //
+      // An entry's string index and position in data plus one, or zero if
+      // the slot is empty.
+      //
+      struct Slot
+      {
+         std::size_t key = 0;
+         std::size_t val = 0;
+      };
+
+
+      T *findEntry(String key) const
+      {
+         if(slots.empty())
+            return nullptr;
+
+         auto const &slot = slots[findSlot(key)];
+         return slot.val ? const_cast<T *>(&data[slot.val - 1].second) : nullptr;
+      }
+
+      std::size_t findSlot(String key) const
+      {
+         auto idx  = static_cast<std::size_t>(key);
+         auto mask = slots.size() - 1;
+
+         for(auto i = Hash(idx) & mask;; i = (i + 1) & mask)
+         {
+            if(!slots[i].val || slots[i].key == idx)
+               return i;
+         }
+      }
+
+      void grow()
+      {
+         slots.assign(slots.empty() ? 16 : slots.size() * 2, Slot());
+
+         auto mask = slots.size() - 1;
+         for(std::size_t val = 0, e = data.size(); val != e; ++val)
+         {
+            auto idx = static_cast<std::size_t>(data[val].first);
+            auto i   = Hash(idx) & mask;
+
+            while(slots[i].val)
+               i = (i + 1) & mask;
+
+            slots[i] = {idx, val + 1};
+         }
+      }
+
+      Storage           data;
+      std::vector<Slot> slots;
+
+
+      // String indexes are dense, so spread them before masking.
+      static std::size_t Hash(std::size_t idx)
+      {
+         std::uint64_t h = idx * UINT64_C(0x9E3779B97F4A7C15);
+         return static_cast<std::size_t>(h ^ (h >> 32));
+      }
+   };
+}
+
+#endif//GDCC__Core__StringTable_H__
+
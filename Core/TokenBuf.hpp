@@ -31,6 +31,13 @@ namespace GDCC::Core
       TokenBuf() : tback{nullptr}, tcurr{nullptr}, tfrnt{nullptr} {}
       virtual ~TokenBuf() {}
 
+      //
+      // avail
+      //
+      // Returns the number of tokens that can be read without underflow.
+      //
+      std::size_t avail() const {return tfrnt - tcurr;}
+
       //
       // get
       //
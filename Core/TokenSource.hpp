@@ -13,6 +13,7 @@
 #ifndef GDCC__Core__TokenSource_H__
 #define GDCC__Core__TokenSource_H__
 
+#include "../Core/Stats.hpp"
 #include "../Core/Token.hpp"
 
 
@@ -34,7 +35,7 @@ namespace GDCC::Core
 
       bool enableToken(TokenType type) {return v_enableToken(type);}
 
-      Token getToken() {return v_getToken();}
+      Token getToken() {StatAdd(StatCount::Tokens); return v_getToken();}
 
    protected:
       // Enables a specified token type. Returns true if token was enabled
@@ -40,6 +40,7 @@ namespace GDCC::Core
    template<typename T, void(T::*D)(), void(T::*E)()>
    class FeatureHold;
    class FileBlock;
+   class FileOutput;
    template<typename I>
    class IntItr;
    class MoveType;
@@ -12,6 +12,8 @@
 
 #include "IR/Block.hpp"
 
+#include "Core/Stats.hpp"
+
 #include "IR/Glyph.hpp"
 #include "IR/IArchive.hpp"
 #include "IR/OArchive.hpp"
@@ -55,6 +57,7 @@ namespace GDCC::IR
       head.labs = Core::Array<Core::String>(Core::Move, labs.begin(), labs.end());
       labs.clear();
       new Statement(std::move(head), link, code);
+      Core::StatAdd(Core::StatCount::Stmnts);
       return *this;
    }
 
@@ -28,7 +28,10 @@ namespace GDCC::IR
    //
    GlyphData *Glyph::findData() const
    {
-      return prog->findGlyphData(str);
+      if(!data)
+         data = prog->findGlyphData(str);
+
+      return data;
    }
 
    //
@@ -36,7 +39,10 @@ namespace GDCC::IR
    //
    GlyphData &Glyph::getData() const
    {
-      return prog->getGlyphData(str);
+      if(!data)
+         data = &prog->getGlyphData(str);
+
+      return *data;
    }
    //
    // operator OArchive << Glyph
@@ -60,6 +66,7 @@ namespace GDCC::IR
    IArchive &operator >> (IArchive &in, Glyph &out)
    {
       out.prog = in.prog;
+      out.data = nullptr;
       return in >> out.str;
    }
 
@@ -46,6 +46,10 @@ namespace GDCC::IR
    private:
       Program     *prog;
       Core::String str;
+
+      // Bound on first lookup. Program never moves its glyph data, and
+      // backing a glyph updates the data in place, so it stays current.
+      mutable GlyphData *data = nullptr;
    };
 
    class GlyphData
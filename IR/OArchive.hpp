@@ -18,6 +18,7 @@
 #include "../Core/Array.hpp"
 #include "../Core/Number.hpp"
 #include "../Core/String.hpp"
+#include "../Core/StringTable.hpp"
 
 #include <ostream>
 #include <unordered_map>
@@ -127,6 +128,9 @@ namespace GDCC::IR
    OArchive &operator << (OArchive &out,
       std::unordered_map<Key, T, Hash, KeyEqual, Allocator> const &in);
 
+   template<typename T>
+   OArchive &operator << (OArchive &out, Core::StringTable<T> const &in);
+
    template<typename T, typename Allocator>
    OArchive &operator << (OArchive &out, std::vector<T, Allocator> const &in);
 
@@ -142,6 +146,18 @@ namespace GDCC::IR
       return out;
    }
 
+   //
+   // operator OArchive << Core::StringTable
+   //
+   template<typename T>
+   OArchive &operator << (OArchive &out, Core::StringTable<T> const &in)
+   {
+      out << in.size();
+      for(auto const &i : in)
+         out << i;
+      return out;
+   }
+
    //
    // operator OArchive << std::pair
    //
@@ -17,6 +17,7 @@
 #include "IR/OArchive.hpp"
 
 #include "Core/Exception.hpp"
+#include "Core/Stats.hpp"
 #include "Core/Warning.hpp"
 
 
@@ -57,8 +58,7 @@ namespace GDCC::IR
    template<typename T>
    static T *FindTable(Program::Table<T> &table, Core::String glyph)
    {
-      auto itr = table.find(glyph);
-      return itr == table.end() ? nullptr : &itr->second;
+      return table.find(glyph);
    }
 
    //
@@ -68,17 +68,7 @@ namespace GDCC::IR
    static T &GetTable(Program::Table<T> &table, Core::String glyph,
       Args &&...args)
    {
-      auto itr = table.find(glyph);
-
-      if(itr == table.end())
-      {
-         itr = table.emplace(std::piecewise_construct,
-            std::forward_as_tuple(glyph),
-            std::forward_as_tuple(std::forward<Args>(args)...)
-            ).first;
-      }
-
-      return itr->second;
+      return table.get(glyph, std::forward<Args>(args)...);
    }
 
    //
@@ -775,6 +765,8 @@ namespace GDCC::IR
    //
    OArchive &operator << (OArchive &out, Program const &in)
    {
+      Core::StatPhase phase{"ir-write"};
+
       out
          << in.tableDJump
          << in.tableFunction
@@ -796,6 +788,8 @@ namespace GDCC::IR
    //
    IArchive &operator >> (IArchive &in, Program &out)
    {
+      Core::StatPhase phase{"ir-read"};
+
       in.prog = &out;
 
       // tableDJump
@@ -23,6 +23,7 @@
 
 #include "../Core/MemItr.hpp"
 #include "../Core/Range.hpp"
+#include "../Core/StringTable.hpp"
 
 #include <unordered_map>
 
@@ -40,7 +41,7 @@ namespace GDCC::IR
    {
    public:
       template<typename T>
-      using Table = std::unordered_map<Core::String, T>;
+      using Table = Core::StringTable<T>;
 
       template<typename T>
       using TableRange = Core::Range<Core::MemItr<typename Table<T>::iterator>>;
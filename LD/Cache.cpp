@@ -0,0 +1,465 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Compilation cache.
+//
+// Each cache entry is one file, named by the SHA-256 digest of its key and
+// holding:
+//    magic "GDCC::CACHE\0"
+//    key (LE4 length, bytes)
+//    dependency count (LE4)
+//    dependencies (LE4 name length, name bytes, LE4 sys, LE4 size, SHA-256)
+//    IR archive (to end of file)
+//
+// The key is made of the tool name, version, and executable's digest, the
+// target, the options used, and the source's name and digest. Entries are written to a
+// temporary file and renamed into place, so concurrent builds sharing a
+// cache directory only ever see complete entries.
+//
+//-----------------------------------------------------------------------------
+
+#include "LD/Cache.hpp"
+
+#include "Core/BinaryIO.hpp"
+#include "Core/Dir.hpp"
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+#include "Core/Path.hpp"
+#include "Core/SHA256.hpp"
+#include "Core/StringBuf.hpp"
+#include "Core/Warning.hpp"
+
+#include "IR/IArchive.hpp"
+#include "IR/OArchive.hpp"
+#include "IR/Program.hpp"
+
+#include "Target/Info.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::LD
+{
+   //
+   // --cache-dir
+   //
+   Option::CStr CacheDir
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("cache-dir")
+         .setGroup("output")
+         .setDescS("Sets a directory for cached compilation results.")
+         .setDescL("Sets a directory for cached compilation results. When "
+            "set, the IR of each source is stored under a key made of the "
+            "source contents, the options, the target, and the compiler "
+            "executable. Sources whose key and included files are unchanged "
+            "are read from the cache instead of being compiled. The directory "
+            "is created if needed. The key does not include __DATE__ and "
+            "__TIME__, nor headers added where they would shadow an included "
+            "file, so clear the cache if either matters.")
+   };
+
+   //
+   // --cache-stats
+   //
+   Option::Bool CacheStats
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("cache-stats")
+         .setGroup("output")
+         .setDescS("Prints compilation cache hits and misses.")
+         .setDescL("Prints compilation cache hits and misses to stderr "
+            "after output is written. Default off."),
+
+      false
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::LD
+{
+   static char const CacheMagic[12] = "GDCC::CACHE";
+
+   static std::size_t CacheHits;
+   static std::size_t CacheMiss;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::LD
+{
+   //
+   // GetCacheOptionLen
+   //
+   // If arg names one of the options that do not affect output, returns the
+   // length of the argument up to the end of the option's name. Otherwise,
+   // returns 0.
+   //
+   static std::size_t GetCacheOptionLen(char const *arg)
+   {
+      if(std::strncmp(arg, "--", 2))
+         return 0;
+
+      std::size_t len = std::strncmp(arg + 2, "no-", 3) ? 2 : 5;
+
+      for(char const *name : {"bc-helper-dir", "cache-dir", "cache-stats", "stats",
+         "time-report"})
+      {
+         auto nameLen = std::strlen(name);
+
+         if(!std::strncmp(arg + len, name, nameLen) &&
+            (!arg[len + nameLen] || arg[len + nameLen] == '='))
+            return len + nameLen;
+      }
+
+      return 0;
+   }
+
+   //
+   // GetCacheKey
+   //
+   static std::string GetCacheKey(char const *inName, Core::FileBlock const &src)
+   {
+      auto &opts = Core::GetOptions();
+
+      std::ostringstream key;
+
+      key << opts.list.name << '\n' << opts.list.version << ' '
+         << Core::GetOptionBuild() << '\n'
+         << static_cast<int>(Target::EngineCur) << ' '
+         << static_cast<int>(Target::FormatCur) << '\n';
+
+      // Options, excluding inputs, output, and those not affecting output.
+      for(auto itr = opts.argv.begin(), end = opts.argv.end(); itr != end; ++itr)
+      {
+         auto arg = *itr;
+
+         if(auto len = GetCacheOptionLen(arg))
+         {
+            // Skip separate argument of --bc-helper-dir, --cache-dir, and
+            // --stats.
+            if(!arg[len] && itr + 1 != end && (!std::strcmp(arg, "--bc-helper-dir") ||
+               !std::strcmp(arg, "--cache-dir") || !std::strcmp(arg, "--stats")))
+               ++itr;
+
+            continue;
+         }
+
+         bool loose = opts.optOutput.data() && !std::strcmp(arg, opts.optOutput.data());
+
+         for(auto input : opts.args)
+            loose = loose || !std::strcmp(arg, input);
+
+         if(!loose)
+            key << arg << '\n';
+      }
+
+      key << inName << '\n' << src.size() << ' '
+         << Core::GetSHA256Hex(src.data(), src.size());
+
+      return key.str();
+   }
+
+   //
+   // GetCachePath
+   //
+   static std::string GetCachePath(std::string const &key)
+   {
+      std::string path{CacheDir.data(), CacheDir.size()};
+      std::string name = Core::GetSHA256Hex(key.data(), key.size()) + ".ir";
+
+      return Core::PathAppend(path, name.data());
+   }
+
+   //
+   // ReadDigest
+   //
+   static bool ReadDigest(char const *&itr, char const *end, Core::SHA256::Digest &out)
+   {
+      if(static_cast<std::size_t>(end - itr) < out.size())
+         return false;
+
+      std::memcpy(out.data(), itr, out.size());
+      itr += out.size();
+      return true;
+   }
+
+   //
+   // ReadLE4
+   //
+   static bool ReadLE4(char const *&itr, char const *end, std::uint_fast32_t &out)
+   {
+      if(end - itr < 4)
+         return false;
+
+      out = Core::ReadLE4(itr);
+      itr += 4;
+      return true;
+   }
+
+   //
+   // ReadStr
+   //
+   static bool ReadStr(char const *&itr, char const *end, std::string &out)
+   {
+      std::uint_fast32_t len;
+      if(!ReadLE4(itr, end, len) || static_cast<std::size_t>(end - itr) < len)
+         return false;
+
+      out.assign(itr, len);
+      itr += len;
+      return true;
+   }
+
+   //
+   // WriteStr
+   //
+   static void WriteStr(std::ostream &out, char const *str, std::size_t len)
+   {
+      Core::WriteLE4(out, len);
+      out.write(str, len);
+   }
+
+   //
+   // IsDependCurrent
+   //
+   // Checks that a dependency still has the recorded size and digest.
+   //
+   static bool IsDependCurrent(std::string const &name,
+      std::uint_fast32_t size, Core::SHA256::Digest const &digest)
+   {
+      try
+      {
+         auto buf = Core::FileOpenBlock(name.data());
+
+         return buf->size() == size &&
+            Core::GetSHA256(buf->data(), buf->size()) == digest;
+      }
+      catch(Core::Exception const &)
+      {
+         return false;
+      }
+   }
+
+   //
+   // LoadCache
+   //
+   static bool LoadCache(std::string const &path, std::string const &key,
+      IR::Program &prog)
+   {
+      std::unique_ptr<Core::FileBlock> buf;
+
+      try
+      {
+         buf = Core::FileOpenBlock(path.data());
+      }
+      catch(Core::Exception const &)
+      {
+         return false;
+      }
+
+      char const *itr = buf->begin(), *end = buf->end();
+
+      if(end - itr < 12 || std::memcmp(itr, CacheMagic, 12))
+         return false;
+      itr += 12;
+
+      std::string str;
+      if(!ReadStr(itr, end, str) || str != key)
+         return false;
+
+      std::uint_fast32_t depC;
+      if(!ReadLE4(itr, end, depC))
+         return false;
+
+      std::vector<Core::FileDepend> deps;
+      while(depC--)
+      {
+         std::uint_fast32_t   sys, size;
+         Core::SHA256::Digest digest;
+
+         if(!ReadStr(itr, end, str) || !ReadLE4(itr, end, sys) ||
+            !ReadLE4(itr, end, size) || !ReadDigest(itr, end, digest))
+            return false;
+
+         if(!IsDependCurrent(str, size, digest))
+            return false;
+
+         deps.push_back({{str.data(), str.size()}, !!sys});
+      }
+
+      Core::StringBuf sbuf{itr, static_cast<std::size_t>(end - itr)};
+      std::istream    in{&sbuf};
+      IR::IArchive    arc{in};
+      arc >> prog;
+
+      // Record dependencies as if the source had been compiled.
+      for(auto const &dep : deps)
+         Core::FileAddDepend(dep.name, dep.sys);
+
+      return true;
+   }
+
+   //
+   // SaveCache
+   //
+   // Failure to write is not an error, as the cache only saves work.
+   //
+   static void SaveCache(std::string const &path, std::string const &key,
+      std::string const &ir)
+   {
+      std::ostringstream out;
+
+      out.write(CacheMagic, 12);
+      WriteStr(out, key.data(), key.size());
+
+      auto const &deps = Core::GetFileDepends();
+      Core::WriteLE4(out, deps.size());
+      for(auto const &dep : deps)
+      {
+         std::uint_fast32_t   size;
+         Core::SHA256::Digest digest;
+
+         try
+         {
+            auto buf = Core::FileOpenBlock(dep.name.data());
+            size   = buf->size();
+            digest = Core::GetSHA256(buf->data(), buf->size());
+         }
+         catch(Core::Exception const &)
+         {
+            return;
+         }
+
+         WriteStr(out, dep.name.data(), dep.name.size());
+         Core::WriteLE4(out, dep.sys);
+         Core::WriteLE4(out, size);
+         out.write(reinterpret_cast<char const *>(digest.data()), digest.size());
+      }
+
+      out.write(ir.data(), ir.size());
+
+      // Write to a unique temporary, then rename into place.
+      std::string tmp = path + '.' + std::to_string(std::random_device{}()) + ".tmp";
+
+      {
+         std::filebuf fbuf;
+         if(!fbuf.open(tmp.data(), std::ios_base::out | std::ios_base::binary))
+            return;
+
+         auto data = out.str();
+         if(fbuf.sputn(data.data(), data.size()) !=
+            static_cast<std::streamsize>(data.size()) || !fbuf.close())
+         {
+            std::remove(tmp.data());
+            return;
+         }
+      }
+
+      if(std::rename(tmp.data(), path.data()))
+         std::remove(tmp.data());
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::LD
+{
+   //
+   // CacheParse
+   //
+   void CacheParse(char const *inName, IR::Program &prog,
+      void (*parse)(char const *inName, IR::Program &prog))
+   {
+      Core::FileClearDepends();
+
+      // Standard input cannot be keyed by name, and without the executable's
+      // digest entries from other builds cannot be told apart.
+      if(!CacheDir.data() || !std::strcmp(inName, "-") || Core::GetOptionBuild().empty())
+         return parse(inName, prog);
+
+      // Create the directory on first use.
+      static bool const dirReady = [] {
+         if(!Core::IsDir(CacheDir.data()))
+            Core::DirCreate(CacheDir.data());
+
+         if(Core::IsDir(CacheDir.data()))
+            return true;
+
+         Core::WarnCommon({}, "cannot create cache directory '",
+            CacheDir.data(), "', not caching");
+         return false;
+      }();
+
+      if(!dirReady)
+         return parse(inName, prog);
+
+      std::string key, path;
+
+      {
+         auto src = Core::FileOpenBlock(inName);
+         key  = GetCacheKey(inName, *src);
+         path = GetCachePath(key);
+      }
+
+      if(LoadCache(path, key, prog))
+         return static_cast<void>(++CacheHits);
+
+      ++CacheMiss;
+
+      // Compile the source on its own, so its IR can be stored.
+      IR::Program tmp;
+      parse(inName, tmp);
+
+      std::ostringstream ir;
+      {
+         IR::OArchive arc{ir};
+         arc.putHead();
+         arc << tmp;
+         arc.putTail();
+      }
+
+      auto irStr = ir.str();
+      SaveCache(path, key, irStr);
+
+      Core::StringBuf sbuf{irStr.data(), irStr.size()};
+      std::istream    in{&sbuf};
+      IR::IArchive    arc{in};
+      arc >> prog;
+   }
+
+   //
+   // PutCacheStats
+   //
+   void PutCacheStats(std::ostream &out)
+   {
+      out << "cache: " << CacheHits << " hits, " << CacheMiss << " misses\n";
+   }
+}
+
+// EOF
+
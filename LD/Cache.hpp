@@ -0,0 +1,50 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Compilation cache.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__LD__Cache_H__
+#define GDCC__LD__Cache_H__
+
+#include "../LD/Types.hpp"
+
+#include "../Option/Bool.hpp"
+#include "../Option/CStr.hpp"
+
+#include <ostream>
+
+
+//----------------------------------------------------------------------------|
+// Extern Objects                                                             |
+//
+
+namespace GDCC::LD
+{
+   extern Option::CStr CacheDir;
+   extern Option::Bool CacheStats;
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::LD
+{
+   // Parses a source into prog, using the cache if enabled. Afterwards,
+   // Core::GetFileDepends lists the files the source depends on.
+   void CacheParse(char const *inName, IR::Program &prog,
+      void (*parse)(char const *inName, IR::Program &prog));
+
+   void PutCacheStats(std::ostream &out);
+}
+
+#endif//GDCC__LD__Cache_H__
+
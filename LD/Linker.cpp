@@ -13,6 +13,7 @@
 #include "LD/Linker.hpp"
 
 #include "BC/Info.hpp"
+#include "BC/Profile.hpp"
 
 #if GDCC_BC_DGE
 #include "BC/DGE/Info.hpp"
@@ -29,11 +30,15 @@
 #include "IR/OArchive.hpp"
 #include "IR/Program.hpp"
 
+#include "LD/Cache.hpp"
+
 #include "Option/Bool.hpp"
 #include "Option/CStrV.hpp"
 
 #include "Target/Info.hpp"
 
+#include <iostream>
+
 
 //----------------------------------------------------------------------------|
 // Options                                                                    |
@@ -106,9 +111,12 @@ namespace GDCC::LD
 
          else if(len == 3 && !std::memcmp(str, "chk", 3)) info->chk(prog);
          else if(len == 3 && !std::memcmp(str, "gen", 3)) info->gen(prog);
+         else if(len == 3 && !std::memcmp(str, "inl", 3)) info->inl(prog);
          else if(len == 3 && !std::memcmp(str, "opt", 3)) info->opt(prog);
          else if(len == 3 && !std::memcmp(str, "pre", 3)) info->pre(prog);
 
+         else if(len == 4 && !std::memcmp(str, "prof", 4)) info->prof(prog);
+
          else
             Core::ErrorExpect({}, "IR processing step", {str, len});
       };
@@ -180,6 +188,9 @@ namespace GDCC::LD
          if(info)
             info->putExtra(prog);
       }
+
+      if(CacheStats)
+         PutCacheStats(std::cerr);
    }
 
    //
@@ -197,7 +208,10 @@ namespace GDCC::LD
       else
       {
          info->chk(prog);
+         info->prof(prog);
          info->pre(prog);
+         if(BC::ProfileIsUsed())
+            info->inl(prog);
          info->opt(prog);
          info->tr(prog);
          info->opt(prog);
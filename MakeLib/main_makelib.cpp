@@ -19,6 +19,7 @@
 
 #include "IR/Program.hpp"
 
+#include "LD/Cache.hpp"
 #include "LD/Linker.hpp"
 
 #include "Option/Bool.hpp"
@@ -60,7 +61,7 @@ static void MakeLib_AS(GDCC::IR::Program &prog, std::string path, char const *na
    if(Progress)
       std::cerr << "gdcc-as " << path << std::endl;
 
-   GDCC::AS::ParseFile(path.data(), prog);
+   GDCC::LD::CacheParse(path.data(), prog, GDCC::AS::ParseFile);
 }
 
 //
@@ -73,7 +74,7 @@ static void MakeLib_CC(GDCC::IR::Program &prog, std::string path, char const *na
    if(Progress)
       std::cerr << "gdcc-cc " << path << std::endl;
 
-   GDCC::CC::ParseFile(path.data(), prog);
+   GDCC::LD::CacheParse(path.data(), prog, GDCC::CC::ParseFile);
 }
 
 //
@@ -86,6 +87,7 @@ static void MakeLib_libGDCC(GDCC::IR::Program &prog)
    GDCC::Core::PathAppend(path, "libGDCC");
 
    MakeLib_CC(prog, path, "alloc.c");
+   MakeLib_CC(prog, path, "prof.c");
 }
 
 //
@@ -12,13 +12,12 @@
 
 #include "NTSC/TSource.hpp"
 
+#include "Core/CharClass.hpp"
 #include "Core/Exception.hpp"
 #include "Core/Parse.hpp"
 #include "Core/Token.hpp"
 #include "Core/Warning.hpp"
 
-#include <cctype>
-
 
 //----------------------------------------------------------------------------|
 // Static Functions                                                           |
@@ -26,14 +25,6 @@
 
 namespace GDCC::NTSC
 {
-   //
-   // IsIdentiChar
-   //
-   static bool IsIdentiChar(int c)
-   {
-      return std::isalnum(c) || c == '_' || c >= 0x80;
-   }
-
    //
    // ReadString
    //
@@ -73,7 +64,7 @@ namespace GDCC::NTSC
       int c = in.get();
       for(;; c = in.get())
       {
-         if(std::isspace(c)) continue;
+         if(Core::IsCharSpace(c)) continue;
          if(c == '#') {SkipComment(in); continue;}
          break;
       }
@@ -95,7 +86,7 @@ namespace GDCC::NTSC
 
       case '.':
          // Is this actually a number?
-         if(std::isdigit(in.peek())) break;
+         if(Core::IsCharDigit(in.peek())) break;
 
          return GDCC_Core_Token_SetStrTok(tok, Dot);
       }
@@ -108,7 +99,7 @@ namespace GDCC::NTSC
       }
 
       // Number token.
-      if(std::isdigit(c) || c == '.')
+      if(Core::IsCharDigit(c) || c == '.')
       {
          in.putback(c);
 
@@ -120,14 +111,10 @@ namespace GDCC::NTSC
       }
 
       // Identifier token.
-      if(IsIdentiChar(c))
+      if(Core::IsCharIdenti(c))
       {
-         std::string str;
-
-         do str += static_cast<char>(c);
-         while((c = in.get()) != EOF && IsIdentiChar(c));
-
-         if(c != EOF) in.unget();
+         std::string str{static_cast<char>(c)};
+         Core::ReadCharClass(in, str, Core::CharIdenti);
 
          tok.str = {str.data(), str.size()};
          tok.tok = Core::TOK_Identi;
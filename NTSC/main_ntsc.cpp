@@ -18,6 +18,7 @@
 #include "Core/Exception.hpp"
 #include "Core/File.hpp"
 #include "Core/Option.hpp"
+#include "Core/Stats.hpp"
 #include "Core/Token.hpp"
 
 #include <iostream>
@@ -112,6 +113,8 @@ static void ProcessFile(std::ostream &out, char const *inName)
    GDCC::NTSC::IStream istr{*buf, inName};
    GDCC::NTSC::TSource tsrc{istr, istr.getOriginSource()};
    GDCC::NTSC::TStream tstr{tsrc};
+
+   GDCC::Core::StatPhase phase{"process"};
    for(GDCC::Core::Token tok; tstr >> tok;)
       GDCC::NTSC::PutToken(out, tok);
 }
@@ -361,7 +361,7 @@ namespace GDCC::Option
 
       // Inter-option comma, if any.
       if(info.lenL && info.lenS)
-         out << (opt->info.nameS ? ',' : ' ') << ' ';
+         out << (opt->info.nameS && opt->info.nameL ? ',' : ' ') << ' ';
 
       // Long option, if any.
       if(info.lenL)
@@ -0,0 +1,302 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Program entry point.
+//
+//-----------------------------------------------------------------------------
+
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+
+#include "Option/Bool.hpp"
+#include "Option/CStr.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+//
+// --blocks
+//
+static GDCC::Option::Bool Blocks
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("blocks")
+      .setGroup("output")
+      .setDescS("Includes block counters in the report.")
+      .setDescL("Includes block counters in the report, listed after their "
+         "function. Default off.")
+};
+
+//
+// --data
+//
+static GDCC::Option::Bool Data
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("data")
+      .setGroup("output")
+      .setDescS("Writes profile data instead of a report.")
+      .setDescL("Writes profile data instead of a report, for use with "
+         "gdcc-ld --profile-use. Default off.")
+};
+
+//
+// --map
+//
+static GDCC::Option::CStr Map
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("map")
+      .setGroup("input")
+      .setDescS("Sets the counter map written by gdcc-ld.")
+      .setDescL("Sets the counter map written by gdcc-ld with --bc-profile, "
+         "which is the output file with .prof appended unless set by "
+         "--bc-profile-map.")
+};
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+//
+// Counter
+//
+class Counter
+{
+public:
+   std::string   glyph;
+   std::string   origin;
+   std::uint64_t count = 0;
+   bool          block = false;
+};
+
+//
+// FuncProf
+//
+class FuncProf
+{
+public:
+   std::string            glyph;
+   std::string            origin;
+   std::vector<Counter *> blocks;
+   std::uint64_t          count = 0;
+};
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+//
+// PutData
+//
+// Writes each function's calls plus its block counts.
+//
+static void PutData(std::ostream &out, std::vector<FuncProf> const &funcs)
+{
+   out << "GDCC::PROFDATA 1\n";
+
+   for(auto const &fn : funcs)
+   {
+      auto count = fn.count;
+      for(auto const &blk : fn.blocks)
+         count += blk->count;
+
+      if(count)
+         out << fn.glyph << ' ' << count << '\n';
+   }
+}
+
+//
+// ReadCounts
+//
+// Reads the counters printed by __GDCC__prof_dump from a log. Counters are
+// cumulative, so the last value printed for each is used.
+//
+static void ReadCounts(std::vector<Counter> &counters, char const *name)
+{
+   auto buf = GDCC::Core::FileOpenStream(name, std::ios_base::in);
+   std::istream in{buf.get()};
+
+   for(std::string line; std::getline(in, line);)
+   {
+      auto pos = line.find("GDCC::PROF ");
+      if(pos == std::string::npos)
+         continue;
+
+      std::istringstream lineIn{line.substr(pos + 11)};
+
+      std::size_t   idx;
+      std::int64_t  count;
+      if(!(lineIn >> idx >> count) || idx >= counters.size())
+         continue;
+
+      // ZDoom prints counts as signed words.
+      if(count < 0)
+         count += std::int64_t(1) << 32;
+
+      counters[idx].count = count;
+   }
+}
+
+//
+// ReadMap
+//
+static std::vector<Counter> ReadMap(char const *name)
+{
+   auto buf = GDCC::Core::FileOpenStream(name, std::ios_base::in);
+   std::istream in{buf.get()};
+
+   std::string line;
+   if(!std::getline(in, line) || line != "GDCC::PROF 1")
+      GDCC::Core::Error({}, "invalid profile map: ", name);
+
+   std::vector<Counter> counters;
+
+   while(std::getline(in, line))
+   {
+      std::istringstream lineIn{line};
+
+      std::size_t idx;
+      std::string kind;
+      Counter     ctr;
+      if(!(lineIn >> idx >> kind >> ctr.glyph) || idx != counters.size())
+         GDCC::Core::Error({}, "invalid profile map: ", name);
+
+      lineIn >> std::ws;
+      std::getline(lineIn, ctr.origin);
+
+      ctr.block = kind == "block";
+      counters.push_back(std::move(ctr));
+   }
+
+   return counters;
+}
+
+//
+// MakeProf
+//
+static void MakeProf()
+{
+   if(!Map.data())
+      GDCC::Core::Error({}, "no profile map");
+
+   auto counters = ReadMap(Map.data());
+
+   auto const &inputs = GDCC::Core::GetOptionArgs();
+   if(inputs.size())
+   {
+      for(auto const &input : inputs)
+         ReadCounts(counters, input);
+   }
+   else
+      ReadCounts(counters, "-");
+
+   // Group counters by function. Block counters precede their function's.
+   std::vector<FuncProf> funcs;
+   std::vector<Counter *> blocks;
+
+   for(auto &ctr : counters)
+   {
+      if(ctr.block)
+      {
+         blocks.push_back(&ctr);
+         continue;
+      }
+
+      funcs.push_back({ctr.glyph, ctr.origin, std::move(blocks), ctr.count});
+      blocks.clear();
+   }
+
+   std::stable_sort(funcs.begin(), funcs.end(),
+      [](FuncProf const &l, FuncProf const &r) {return l.count > r.count;});
+
+   auto outName = GDCC::Core::GetOptionOutput();
+   if(!outName) outName = "-";
+
+   auto buf = GDCC::Core::FileOpenStream(outName, std::ios_base::out);
+   std::ostream out{buf.get()};
+
+   if(Data)
+      return PutData(out, funcs);
+
+   std::uint64_t total = 0;
+   for(auto const &fn : funcs)
+      total += fn.count;
+
+   out << "calls: " << total << '\n';
+
+   for(auto const &fn : funcs)
+   {
+      if(!fn.count)
+         break;
+
+      out << std::setw(12) << fn.count << "  " << fn.glyph << "  "
+         << fn.origin << '\n';
+
+      if(Blocks) for(auto const &blk : fn.blocks)
+      {
+         if(blk->count)
+            out << std::setw(16) << blk->count << "  " << blk->origin << '\n';
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+//
+// main
+//
+int main(int argc, char *argv[])
+{
+   auto &opts = GDCC::Core::GetOptions();
+
+   opts.list.name     = "gdcc-prof";
+   opts.list.nameFull = "GDCC Profile Report";
+
+   opts.list.usage = "[option]... --map <map> [log]...";
+
+   opts.list.descS =
+      "Reports the counters printed by __GDCC__prof_dump in logs, by "
+      "function and most called first. Logs default to stdin, and output "
+      "defaults to stdout.";
+
+   try
+   {
+      GDCC::Core::ProcessOptions(opts, argc, argv, false);
+      MakeProf();
+   }
+   catch(std::exception const &e)
+   {
+      std::cerr << "ERROR: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+   }
+   catch(int e)
+   {
+      return e;
+   }
+}
+
+// EOF
+
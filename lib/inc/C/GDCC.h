@@ -29,6 +29,20 @@
 //
 #define __GDCC__Sta __glyph(int, "___GDCC__Sta")
 
+//
+// __GDCC__ProfData
+//
+// Address of the profiling counters.
+//
+#define __GDCC__ProfData ((unsigned __sta *)__glyph(int, "___GDCC__ProfCount"))
+
+//
+// __GDCC__ProfSize
+//
+// Number of profiling counters, which is 0 unless linked with --bc-profile.
+//
+#define __GDCC__ProfSize __glyph(unsigned, "___GDCC__ProfSize")
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -44,6 +58,12 @@ extern void __sta *__GDCC__alloc(void __sta *_ptr, __size_t _size);
 [[call("StkCall")]]
 extern void __GDCC__alloc_dump(void);
 
+[[call("StkCall")]]
+extern void __GDCC__prof_dump(void);
+
+[[call("StkCall")]]
+extern void __GDCC__prof_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,76 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2024 David Hill
+//
+// See COPYLIB for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Profiling counter routines.
+//
+//-----------------------------------------------------------------------------
+
+#include <GDCC.h>
+
+#if __GDCC_Family__ZDACS__
+#include <ACS_ZDoom.h>
+#endif
+
+#if __GDCC_Engine__Doominati__
+#include <Doominati.h>
+#endif
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+//
+// __GDCC__prof_dump
+//
+[[call("StkCall")]]
+void __GDCC__prof_dump(void)
+{
+   for(unsigned i = 0, e = __GDCC__ProfSize; i != e; ++i)
+   {
+      unsigned count = __GDCC__ProfData[i];
+
+      if(!count) continue;
+
+      #if __GDCC_Family__ZDACS__
+      ACS_BeginPrint();
+
+      for(char const *s = "GDCC::PROF "; *s; ++s)
+         ACS_PrintChar(*s);
+
+      ACS_PrintNumber(i);
+      ACS_PrintChar(' ');
+      ACS_PrintNumber(count);
+
+      ACS_EndLog();
+      #endif
+
+      #if __GDCC_Engine__Doominati__
+      for(char const *s = "GDCC::PROF "; *s; ++s)
+         DGE_PrintChar(*s);
+
+      DGE_PrintWordD(i);
+      DGE_PrintChar(' ');
+      DGE_PrintWordD(count);
+      DGE_PrintChar('\n');
+      #endif
+   }
+}
+
+//
+// __GDCC__prof_reset
+//
+[[call("StkCall")]]
+void __GDCC__prof_reset(void)
+{
+   for(unsigned i = 0, e = __GDCC__ProfSize; i != e; ++i)
+      __GDCC__ProfData[i] = 0;
+}
+
+// EOF
+
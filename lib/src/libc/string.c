@@ -16,6 +16,7 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #if __GDCC_Family__ZDACS__
@@ -129,6 +130,15 @@ void *memcpy(void *restrict s1, void const *restrict s2, size_t n)
    char       *i1 = s1;
    char const *i2 = s2;
 
+   #if !__GDCC_Family__ZDACS__
+   // Copy whole words while both pointers are aligned.
+   if(!(((uintptr_t)i1 | (uintptr_t)i2) & (sizeof(int) - 1)))
+   {
+      for(; n >= sizeof(int); n -= sizeof(int), i1 += sizeof(int), i2 += sizeof(int))
+         *(int *)i1 = *(int const *)i2;
+   }
+   #endif
+
    while(n--)
       *i1++ = *i2++;
 
@@ -428,7 +438,20 @@ char *strtok(char *restrict s1, char const *restrict s2)
 //
 void *memset(void *s, int c, size_t n)
 {
-   for(char *i = s; n--;)
+   char *i = s;
+
+   #if !__GDCC_Family__ZDACS__
+   // Set whole words while the pointer is aligned.
+   if(!((uintptr_t)i & (sizeof(int) - 1)))
+   {
+      unsigned w = (unsigned char)c * 0x01010101u;
+
+      for(; n >= sizeof(int); n -= sizeof(int), i += sizeof(int))
+         *(unsigned *)i = w;
+   }
+   #endif
+
+   while(n--)
       *i++ = (char)c;
 
    return s;